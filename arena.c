@@ -0,0 +1,93 @@
+#include "arena.h"
+
+#include <stdalign.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "common.h"
+
+struct ArenaBlock {
+    ArenaBlock *next;
+    size_t cap;
+    size_t pos;
+    alignas(max_align_t) char data[];
+};
+
+#define ARENA_ALIGN alignof(max_align_t)
+
+void arena_init(Arena *a, size_t block_size)
+{
+    *a = (Arena) { .block_size = block_size ? block_size : ARENA_DEFAULT_BLOCK };
+}
+
+static ArenaBlock *arena_grow(Arena *a, size_t size)
+{
+    size_t cap = size > a->block_size ? size : a->block_size;
+    ArenaBlock *b = malloc(sizeof(*b) + cap);
+    if (!b) PANIC("Out of memory");
+
+    b->next = a->head;
+    b->cap = cap;
+    b->pos = 0;
+    a->head = b;
+    a->reserved += cap;
+    a->blocks++;
+    return b;
+}
+
+void *arena_alloc(Arena *a, size_t size)
+{
+    size = (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+
+    ArenaBlock *b = a->head;
+    if (!b || b->cap - b->pos < size) b = arena_grow(a, size);
+
+    void *out = b->data + b->pos;
+    b->pos += size;
+
+    a->used += size;
+    if (a->used > a->high_water) a->high_water = a->used;
+    return out;
+}
+
+void arena_reset(Arena *a)
+{
+    ArenaBlock *b = a->head;
+    if (!b) return;
+
+    // Keep the most recent block: for a host lexing many similar units it is
+    // usually big enough for the next one on its own.
+    ArenaBlock *next = b->next;
+    while (next) {
+        ArenaBlock *n = next->next;
+        a->reserved -= next->cap;
+        a->blocks--;
+        free(next);
+        next = n;
+    }
+
+    b->next = NULL;
+    b->pos = 0;
+    a->used = 0;
+}
+
+void arena_free(Arena *a)
+{
+    ArenaBlock *b = a->head;
+    while (b) {
+        ArenaBlock *next = b->next;
+        free(b);
+        b = next;
+    }
+
+    a->head = NULL;
+    a->used = 0;
+    a->reserved = 0;
+    a->blocks = 0;
+}
+
+void arena_print_stats(const Arena *a, FILE *f)
+{
+    fprintf(f, "arena: %zu bytes used, %zu high water, %zu reserved in %zu blocks\n",
+            a->used, a->high_water, a->reserved, a->blocks);
+}
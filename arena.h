@@ -0,0 +1,35 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+typedef struct ArenaBlock ArenaBlock;
+
+// Bump-pointer allocator owning all memory of one compilation unit.  There
+// is no per-allocation free: everything is released at once by arena_reset
+// (which keeps one block around for reuse) or arena_free.
+//
+// next_token allocates only from here: materialized strings and the
+// interner.  Arrays that grow with the input stay on malloc/realloc on
+// purpose: token stream columns, diagnostics, the line index and the push
+// and relex buffers.  Growing them in an arena would strand every outgrown
+// copy until the unit ends, and they are freed on their own schedule.
+typedef struct {
+    ArenaBlock *head;
+    size_t block_size;
+    size_t used;
+    size_t high_water;
+    size_t reserved;
+    size_t blocks;
+} Arena;
+
+#define ARENA_DEFAULT_BLOCK (64 * 1024)
+
+void arena_init(Arena *a, size_t block_size);
+void *arena_alloc(Arena *a, size_t size);
+void arena_reset(Arena *a);
+void arena_free(Arena *a);
+void arena_print_stats(const Arena *a, FILE *f);
+
+#endif // ARENA_H
@@ -0,0 +1,917 @@
+#include <ctype.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "charclass.h"
+#include "common.h"
+#include "lexer.h"
+#include "dfa.gen.h"
+#include "lines.h"
+#include "number.h"
+#include "parallel.h"
+#include "push.h"
+#include "relex.h"
+#include "scan.h"
+#include "source.h"
+#include "tokbin.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define cycles() __rdtsc()
+#else
+#define cycles() 0
+#endif
+
+#ifdef __GLIBC__
+#include <malloc.h>
+
+// Heap bytes in use, from glibc's own statistics, so --json can report how
+// much lexing took.
+static size_t heap_in_use(void)
+{
+    struct mallinfo2 mi = mallinfo2();
+    return mi.uordblks + mi.hblkhd;
+}
+#else
+static size_t heap_in_use(void)
+{
+    return 0;
+}
+#endif
+
+// The original stdio lexer, kept as the "before" baseline: every byte goes
+// through fgetc, and every peek through fgetc + ungetc.
+
+typedef struct {
+    TokenType type;
+    union {
+        int number_value;
+        char *string_value;
+    } value;
+} LegacyToken;
+
+static char legacy_take_char(FILE *f)
+{
+    char ret = fgetc(f);
+    if (ferror(f)) PANIC("Cannot read file: %m");
+
+    return ret;
+}
+
+static char legacy_peek_char(FILE *f)
+{
+    char ret = legacy_take_char(f);
+    ungetc(ret, f);
+    return ret;
+}
+
+static char *legacy_take_ident(FILE *f)
+{
+    char buf[256] = { 0 };
+    size_t str_len = 0;
+
+    char c;
+    while(isalnum(c = legacy_peek_char(f)) || c == '_') {
+        legacy_take_char(f);
+        buf[str_len++] = c;
+    }
+
+    char *out = malloc(str_len + 1);
+    memcpy(out, buf, str_len);
+    out[str_len] = '\0';
+
+    return out;
+}
+
+static int legacy_take_num(FILE *f)
+{
+    int out = 0;
+    char c;
+    while(isdigit(c = legacy_peek_char(f)) || c == '_') {
+        legacy_take_char(f);
+        if (c == '_') continue;
+        out *= 10;
+        out += c - '0';
+    }
+
+    return out;
+}
+
+static char *legacy_take_string(FILE *f, bool single_quote)
+{
+    size_t cap = 1024;
+    size_t len = 0;
+    char *buf = malloc(cap);
+
+    bool escaping = false;
+    char c;
+    char target_quote = single_quote ? '\'' : '"';
+    while ((c = legacy_take_char(f)) != target_quote || escaping) {
+        if (feof(f)) break;
+        if (escaping) {
+            switch (c) {
+                case 'n': c = '\n'; break;
+                case 't': c = '\t'; break;
+            }
+        }
+
+        if (escaping || c != '\\') {
+            if (len >= cap - 1) buf = realloc(buf, cap *= 2);
+            buf[len++] = c;
+            escaping = false;
+        } else {
+            escaping = true;
+            continue;
+        }
+    }
+
+    buf[len] = '\0';
+    return buf;
+}
+
+static LegacyToken legacy_next_token(FILE *f)
+{
+    char c;
+    for (;;) {
+        switch (c = legacy_take_char(f)) {
+            case '+': return (LegacyToken){ TOK_PLUS, { 0 } };
+            case '-': return (LegacyToken){ TOK_MINUS, { 0 } };
+            case '(': return (LegacyToken){ TOK_LPAREN, { 0 } };
+            case ')': return (LegacyToken){ TOK_RPAREN, { 0 } };
+            case '{': return (LegacyToken){ TOK_LBRACE, { 0 } };
+            case '}': return (LegacyToken){ TOK_RBRACE, { 0 } };
+            case '[': return (LegacyToken){ TOK_LBRACKET, { 0 } };
+            case ']': return (LegacyToken){ TOK_RBRACKET, { 0 } };
+            case ';': return (LegacyToken){ TOK_SEMICOLON, { 0 } };
+            case '=': return (LegacyToken){ TOK_EQUALS, { 0 } };
+            case '/': {
+                if (legacy_peek_char(f) == '/') {
+                    legacy_take_char(f);
+                    char p;
+                    while ((p = legacy_peek_char(f)) != '\n' && p != '\0' && !feof(f)) {
+                        legacy_take_char(f);
+                    }
+                    continue;
+                }
+            } break;
+            case '\'':
+            case '"': {
+                char *str = legacy_take_string(f, c == '\'');
+                return (LegacyToken){ TOK_STRING, .value.string_value = str };
+            } break;
+        }
+
+        if (isspace(c)) continue;
+        else if (isalpha(c) || c == '_') {
+            ungetc(c, f);
+            char *ident = legacy_take_ident(f);
+            TokenType type = strcmp(ident, "let") ? TOK_IDENT : TOK_LET;
+            if (type != TOK_IDENT) free(ident);
+            return (LegacyToken){ type, .value.string_value = type == TOK_IDENT ? ident : 0 };
+        } else if (isdigit(c)) {
+            ungetc(c, f);
+            return (LegacyToken){ TOK_NUMBER, .value.number_value = legacy_take_num(f) };
+        }
+
+        if (c == EOF) return (LegacyToken){ 0 };
+
+        // The old grammar is a subset of the current one; stop where it
+        // ends rather than failing the whole run.
+        return (LegacyToken){ _TOK_COUNT, { 0 } };
+    }
+}
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void free_tok(LegacyToken tok)
+{
+    if (tok.type == TOK_IDENT || tok.type == TOK_STRING) free(tok.value.string_value);
+}
+
+static void report(const char *name, size_t bytes, size_t tokens, double secs)
+{
+    printf("%-10s %10zu bytes %9zu tokens %8.3f s %9.2f MB/s\n",
+           name, bytes, tokens, secs, bytes / secs / 1e6);
+}
+
+static void bench_legacy(const char *path, size_t bytes)
+{
+    FILE *f = fopen(path, "r");
+    if (!f) PANIC("Cannot open %s: %m", path);
+
+    size_t tokens = 0;
+    double start = now();
+    LegacyToken tok;
+    do {
+        tok = legacy_next_token(f);
+        free_tok(tok);
+        tokens++;
+    } while (tok.type != TOK_EOF && tok.type != _TOK_COUNT);
+    if (tok.type == _TOK_COUNT) bytes = ftell(f);
+    report(tok.type == _TOK_COUNT ? "stdio*" : "stdio", bytes, tokens, now() - start);
+
+    fclose(f);
+}
+
+static void bench_lex_with(const char *name, Source *src, double start, Token (*next)(Lexer *))
+{
+    Lexer l;
+    lexer_init(&l, src->data, src->len, NULL, NULL);
+
+    size_t tokens = 0;
+    Token tok;
+    do {
+        tok = next(&l);
+        tokens++;
+    } while (tok.type != TOK_EOF);
+    report(name, src->len, tokens, now() - start);
+}
+
+static void bench_lex(const char *name, Source *src, double start)
+{
+    bench_lex_with(name, src, start, next_token);
+}
+
+// Lexes like the stdio baseline does: every identifier and string ends up as
+// a NUL-terminated string, here interned or copied into one arena.
+static void bench_materialize(const char *path)
+{
+    Source src;
+    if (!source_open(&src, path)) PANIC("Cannot open %s: %m", path);
+
+    Arena arena;
+    arena_init(&arena, 0);
+
+    double start = now();
+    Interner interner;
+    interner_init(&interner, &arena);
+
+    Lexer l;
+    lexer_init(&l, src.data, src.len, &arena, &interner);
+
+    size_t tokens = 0;
+    Token tok;
+    do {
+        tok = next_token(&l);
+        if (tok.type == TOK_IDENT || tok.type == TOK_STRING) token_string(&l, tok);
+        tokens++;
+    } while (tok.type != TOK_EOF);
+    report("arena", src.len, tokens, now() - start);
+    arena_print_stats(&arena, stdout);
+    interner_print_stats(&interner, stdout);
+
+    arena_free(&arena);
+    source_free(&src);
+}
+
+static int ctype_kind(char c)
+{
+    if (c & 0x80) return CC_UTF8;
+    if (isspace(c)) return CC_SPACE;
+    if (isalpha(c) || c == '_') return CC_IDENT_START;
+    if (isdigit(c)) return CC_DIGIT;
+    if (c == '\'' || c == '"') return CC_QUOTE;
+#define PUNCT_CHAR(c) c,
+    static const char punct_start[] = { DFA_START_BYTES(PUNCT_CHAR) 0 };
+#undef PUNCT_CHAR
+    return strchr(punct_start, c) && c ? CC_OP : CC_NONE;
+}
+
+// Classifies every byte of the input through <ctype.h> the way next_token
+// used to, and through char_class.
+static void bench_classify(const char *path)
+{
+    Source src;
+    if (!source_open(&src, path)) PANIC("Cannot open %s: %m", path);
+
+    size_t ctype_counts[CC_KIND + 1] = { 0 };
+    double start = now();
+    for (size_t i = 0; i < src.len; i++) ctype_counts[ctype_kind(src.data[i])]++;
+    double ctype_secs = now() - start;
+
+    size_t table_counts[CC_KIND + 1] = { 0 };
+    start = now();
+    for (size_t i = 0; i < src.len; i++) table_counts[char_kind(src.data[i])]++;
+    double table_secs = now() - start;
+
+    if (memcmp(ctype_counts, table_counts, sizeof(table_counts))) PANIC("ctype and char_class disagree");
+    printf("%-10s %10zu bytes %8.3f ns/byte\n", "ctype", src.len, ctype_secs * 1e9 / src.len);
+    printf("%-10s %10zu bytes %8.3f ns/byte\n", "charclass", src.len, table_secs * 1e9 / src.len);
+
+    source_free(&src);
+}
+
+static Token *collect(const Source *src, TokenType type, size_t *count)
+{
+    size_t cap = 1024;
+    Token *toks = malloc(cap * sizeof(*toks));
+    *count = 0;
+
+    Lexer l;
+    lexer_init(&l, src->data, src->len, NULL, NULL);
+    for (Token tok; (tok = next_token(&l)).type != TOK_EOF;) {
+        if (tok.type != type) continue;
+        if (*count == cap) toks = realloc(toks, (cap *= 2) * sizeof(*toks));
+        toks[(*count)++] = tok;
+    }
+    return toks;
+}
+
+// Converts every decimal integer literal of the input with a
+// digit-at-a-time loop and with parse_decimal.
+static void bench_integers(const Source *src)
+{
+    size_t count;
+    Token *nums = collect(src, TOK_NUMBER, &count);
+    size_t decimal = 0;
+    for (size_t i = 0; i < count; i++) {
+        const char *p = src->data + nums[i].offset;
+        if (nums[i].len < 2 || !strchr("xXbB", p[1])) nums[decimal++] = nums[i];
+    }
+    count = decimal;
+    if (!count) goto out;
+
+    int64_t naive_sum = 0;
+    double start = now();
+    for (size_t i = 0; i < count; i++) {
+        int64_t v = 0;
+        const char *p = src->data + nums[i].offset;
+        for (const char *e = p + nums[i].len; p < e; p++) {
+            if (*p != '_') v = v * 10 + (*p - '0');
+        }
+        naive_sum += v;
+    }
+    double naive_secs = now() - start;
+
+    int64_t swar_sum = 0;
+    start = now();
+    for (size_t i = 0; i < count; i++) {
+        int64_t v;
+        const char *p = src->data + nums[i].offset;
+        parse_decimal(p, p + nums[i].len, &v);
+        swar_sum += v;
+    }
+    double swar_secs = now() - start;
+
+    if (naive_sum != swar_sum) PANIC("Integer conversions disagree");
+    printf("%-10s %10zu numbers %8.2f ns/literal\n", "digitwise", count, naive_secs * 1e9 / count);
+    printf("%-10s %10zu numbers %8.2f ns/literal\n", "swar", count, swar_secs * 1e9 / count);
+
+out:
+    free(nums);
+}
+
+// Converts every float literal of the input with strtod and with
+// parse_float.  strtod gets NUL-terminated copies made up front.
+static void bench_floats(const Source *src)
+{
+    size_t count;
+    Token *nums = collect(src, TOK_FLOAT, &count);
+    if (!count) goto out;
+
+    size_t size = 0;
+    for (size_t i = 0; i < count; i++) size += nums[i].len + 1;
+    char *copies = malloc(size);
+    char *c = copies;
+    for (size_t i = 0; i < count; i++) {
+        memcpy(c, src->data + nums[i].offset, nums[i].len);
+        c += nums[i].len;
+        *c++ = '\0';
+    }
+
+    double strtod_sum = 0;
+    double start = now();
+    for (c = copies; c < copies + size; c += strlen(c) + 1) strtod_sum += strtod(c, NULL);
+    double strtod_secs = now() - start;
+
+    double fast_sum = 0;
+    start = now();
+    for (size_t i = 0; i < count; i++) {
+        const char *p = src->data + nums[i].offset;
+        fast_sum += parse_float(p, p + nums[i].len);
+    }
+    double fast_secs = now() - start;
+
+    if (strtod_sum != fast_sum) PANIC("Float conversions disagree");
+    printf("%-10s %10zu floats %9.2f ns/literal\n", "strtod", count, strtod_secs * 1e9 / count);
+    printf("%-10s %10zu floats %9.2f ns/literal\n", "lemire", count, fast_secs * 1e9 / count);
+
+    free(copies);
+out:
+    free(nums);
+}
+
+static void bench_numbers(const char *path)
+{
+    Source src;
+    if (!source_open(&src, path)) PANIC("Cannot open %s: %m", path);
+
+    bench_integers(&src);
+    bench_floats(&src);
+
+    source_free(&src);
+}
+
+static void bench_buffered(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (!f) PANIC("Cannot open %s: %m", path);
+
+    double start = now();
+    Source src;
+    source_read(&src, f);
+    fclose(f);
+
+    bench_lex("buffered", &src, start);
+    source_free(&src);
+}
+
+static void bench_mapped(const char *path)
+{
+    double start = now();
+    Source src;
+    if (!source_open(&src, path)) PANIC("Cannot open %s: %m", path);
+
+    bench_lex(src.mapped ? "mmap" : "fallback", &src, start);
+    source_free(&src);
+}
+
+// Lexes the whole input into a TokenStream in one call.
+static void bench_stream(const char *path)
+{
+    Source src;
+    if (!source_open(&src, path)) PANIC("Cannot open %s: %m", path);
+
+    double start = now();
+    Lexer l;
+    lexer_init(&l, src.data, src.len, NULL, NULL);
+    TokenStream ts = { 0 };
+    lex_all(&l, &ts);
+    double secs = now() - start;
+
+    size_t stored = ts.count * (sizeof(*ts.types) + sizeof(*ts.offsets) + sizeof(*ts.lens))
+        + ts.value_count * sizeof(*ts.values);
+    report("lex_all", src.len, ts.count, secs);
+    printf("%-10s %10.2f Mtokens/s %6.2f bytes/token stored\n", "", ts.count / secs / 1e6, (double)stored / ts.count);
+
+    token_stream_free(&ts);
+    source_free(&src);
+}
+
+// lex_all_parallel with interning on 1..8 threads, against lex_all.
+static void bench_parallel(const char *path)
+{
+    Source src;
+    if (!source_open(&src, path)) PANIC("Cannot open %s: %m", path);
+
+    TokenStream serial = { 0 };
+    double base = 0;
+    for (int threads = 0; threads <= 8; threads = threads ? threads * 2 : 1) {
+        Arena arena;
+        arena_init(&arena, 0);
+        Interner interner;
+        interner_init(&interner, &arena);
+
+        double start = now();
+        Lexer l;
+        lexer_init(&l, src.data, src.len, &arena, &interner);
+        TokenStream ts = { 0 };
+        if (threads) {
+            lex_all_parallel(&l, &ts, threads);
+        } else {
+            lex_all(&l, &ts);
+        }
+        double secs = now() - start;
+
+        char name[16];
+        if (threads) {
+            snprintf(name, sizeof(name), "%d thread%s", threads, threads > 1 ? "s" : "");
+            report(name, src.len, ts.count, secs);
+            printf("%-10s %10.2fx\n", "", base / secs);
+            token_stream_free(&ts);
+        } else {
+            report("serial", src.len, ts.count, secs);
+            serial = ts;
+            base = secs;
+        }
+        arena_free(&arena);
+    }
+
+    token_stream_free(&serial);
+    source_free(&src);
+}
+
+// Reads the file in pieces of `piece` bytes and pushes each one into the
+// lexer as it arrives.
+static void bench_push(const char *path, size_t piece)
+{
+    Source src;
+    if (!source_open(&src, path)) PANIC("Cannot open %s: %m", path);
+
+    FILE *f = fopen(path, "r");
+    if (!f) PANIC("Cannot open %s: %m", path);
+    char *buf = malloc(piece);
+    if (!buf) PANIC("Out of memory");
+
+    double start = now();
+    PushLexer p;
+    push_lexer_init(&p, NULL, NULL);
+    TokenStream ts = { 0 };
+    size_t n;
+    do {
+        n = fread(buf, 1, piece, f);
+        if (ferror(f)) PANIC("Cannot read %s: %m", path);
+        if (!push_lexer_feed(&p, buf, n, n < piece, &ts)) PANIC("Input too large");
+    } while (n == piece);
+    double secs = now() - start;
+
+    char name[16];
+    snprintf(name, sizeof(name), "push %zuK", piece / 1024);
+    report(name, src.len, ts.count, secs);
+
+    push_lexer_free(&p);
+    token_stream_free(&ts);
+    free(buf);
+    fclose(f);
+    source_free(&src);
+}
+
+static void apply_edit(char *text, size_t *len, size_t offset, size_t removed, const char *inserted, size_t n)
+{
+    memmove(text + offset + n, text + offset + removed, *len - offset - removed);
+    memcpy(text + offset, inserted, n);
+    *len += n - removed;
+}
+
+// Replays an editing session: at random line starts, a line is typed one
+// key at a time and then erased with backspace.  Every keystroke is an edit
+// passed to relex; a full lex_all of the text is timed for comparison.
+static void bench_edits(const char *path)
+{
+    static const char typed[] = "\nlet total = count + 25 - (limit + x);";
+    size_t n = sizeof(typed) - 1;
+
+    Source src;
+    if (!source_open(&src, path)) PANIC("Cannot open %s: %m", path);
+    size_t len = src.len;
+    char *text = malloc(len + n);
+    if (!text) PANIC("Out of memory");
+    memcpy(text, src.data, len);
+
+    Lexer l;
+    lexer_init(&l, text, len, NULL, NULL);
+    RelexStream rs;
+    double start = now();
+    relex_stream_init(&rs, &l);
+    double full = now() - start;
+
+    size_t edits = 0;
+    double total = 0, worst = 0;
+    uint64_t seed = 88172645463325252ull;
+    for (int round = 0; round < 50; round++) {
+        seed ^= seed << 13, seed ^= seed >> 7, seed ^= seed << 17;
+        const char *line = memchr(text + seed % len, '\n', len - seed % len);
+        size_t at = line ? (size_t)(line - text) + 1 : len;
+
+        for (size_t i = 0; i < 2 * n; i++) {
+            bool typing = i < n;
+            size_t pos = typing ? at + i : at + 2 * n - i - 1;
+            apply_edit(text, &len, pos, !typing, typing ? typed + i : "", typing);
+
+            start = now();
+            lexer_init(&l, text, len, NULL, NULL);
+            relex(&l, &rs, pos, !typing, typing);
+            double secs = now() - start;
+            total += secs;
+            if (secs > worst) worst = secs;
+            edits++;
+        }
+    }
+
+    printf("%-10s %10zu edits %8.1f us/edit %8.1f us worst %8.1f us full lex\n", "relex", edits,
+           total / edits * 1e6, worst * 1e6, full * 1e6);
+
+    relex_stream_free(&rs);
+    free(text);
+    source_free(&src);
+}
+
+// Dumps the tokens as text with print_tok and in the binary format, both to
+// /dev/null, then writes the binary form to a file and maps it back in.
+static void bench_emit(const char *path)
+{
+    Source src;
+    if (!source_open(&src, path)) PANIC("Cannot open %s: %m", path);
+    Arena arena;
+    arena_init(&arena, 0);
+    Interner interner;
+    interner_init(&interner, &arena);
+    Lexer l;
+    lexer_init(&l, src.data, src.len, &arena, &interner);
+    TokenStream ts = { 0 };
+    lex_all(&l, &ts);
+
+    int null = open("/dev/null", O_WRONLY);
+    if (null < 0) PANIC("Cannot open /dev/null: %m");
+
+    fflush(stdout);
+    int saved = dup(1);
+    dup2(null, 1);
+    double start = now();
+    size_t value = 0;
+    for (size_t i = 0; i < ts.count; i++) print_tok(&l, token_stream_get(&ts, i, &value));
+    fflush(stdout);
+    double text = now() - start;
+    dup2(saved, 1);
+    close(saved);
+
+    start = now();
+    if (!tokbin_write(null, &ts)) PANIC("Cannot write tokens: %m");
+    double bin = now() - start;
+    close(null);
+
+    char tmp[] = "/tmp/bench-tokens-XXXXXX";
+    int fd = mkstemp(tmp);
+    if (fd < 0 || !tokbin_write(fd, &ts)) PANIC("Cannot write %s: %m", tmp);
+    off_t size = lseek(fd, 0, SEEK_END);
+    close(fd);
+
+    start = now();
+    TokenStream back = { 0 };
+    if (!tokbin_load(tmp, &back)) PANIC("Cannot read %s", tmp);
+    double read = now() - start;
+    unlink(tmp);
+
+    report("emit text", src.len, ts.count, text);
+    report("emit bin", src.len, ts.count, bin);
+    report("read bin", src.len, back.count, read);
+    printf("%-10s %10.2f bytes/token binary\n", "", (double)size / ts.count);
+
+    token_stream_free(&back);
+    token_stream_free(&ts);
+    arena_free(&arena);
+    source_free(&src);
+}
+
+typedef struct {
+    const Source *src;
+    size_t tokens;
+    pthread_t thread;
+} Job;
+
+static void *lex_job(void *arg)
+{
+    Job *job = arg;
+    Arena arena;
+    arena_init(&arena, 0);
+    Interner interner;
+    interner_init(&interner, &arena);
+
+    Lexer l;
+    lexer_init(&l, job->src->data, job->src->len, &arena, &interner);
+    TokenStream ts = { 0 };
+    lex_all(&l, &ts);
+    job->tokens = ts.count;
+
+    token_stream_free(&ts);
+    arena_free(&arena);
+    return NULL;
+}
+
+// Independent lexers, one per thread, each lexing its own copy of the input
+// as a server lexing separate scripts would.  Throughput is the total.
+static void bench_independent(const char *path)
+{
+    Source src;
+    if (!source_open(&src, path)) PANIC("Cannot open %s: %m", path);
+
+    Job jobs[8];
+    for (int threads = 1; threads <= 8; threads *= 2) {
+        double start = now();
+        for (int i = 0; i < threads; i++) {
+            jobs[i].src = &src;
+            if (pthread_create(&jobs[i].thread, NULL, lex_job, &jobs[i])) PANIC("Cannot create thread");
+        }
+        size_t tokens = 0;
+        for (int i = 0; i < threads; i++) {
+            pthread_join(jobs[i].thread, NULL);
+            tokens += jobs[i].tokens;
+        }
+
+        char name[16];
+        snprintf(name, sizeof(name), "%dx lexer", threads);
+        report(name, src.len * threads, tokens, now() - start);
+    }
+
+    source_free(&src);
+}
+
+// Builds the line index with each set of kernels, then finds the line and
+// column of every token.
+static void bench_lines(const char *path)
+{
+    Source src;
+    if (!source_open(&src, path)) PANIC("Cannot open %s: %m", path);
+
+    const char *best = scan.name;
+    const char *names[] = { "scalar", "sse2", "avx2" };
+    LineIndex li = { 0 };
+    for (size_t i = 0; i < sizeof(names)/sizeof(*names); i++) {
+        if (!scan_use(names[i])) continue;
+        line_index_free(&li);
+        double start = now();
+        if (!line_index_build(&li, src.data, src.len)) PANIC("Input too large");
+        double secs = now() - start;
+
+        char name[16];
+        snprintf(name, sizeof(name), "nl-%s", names[i]);
+        printf("%-10s %10zu bytes %9zu lines  %8.3f s %9.2f MB/s\n", name, src.len, li.count, secs, src.len / secs / 1e6);
+    }
+    scan_use(best);
+
+    Lexer l;
+    lexer_init(&l, src.data, src.len, NULL, NULL);
+    TokenStream ts = { 0 };
+    lex_all(&l, &ts);
+
+    double start = now();
+    uint64_t sum = 0;
+    for (size_t i = 0; i < ts.count; i++) {
+        uint32_t line, col;
+        line_index_find(&li, ts.offsets[i], &line, &col);
+        sum += line + col;
+    }
+    double secs = now() - start;
+    printf("%-10s %10zu tokens %8.1f ns/lookup (%" PRIu64 ")\n", "line/col", ts.count, secs / ts.count * 1e9, sum);
+
+    token_stream_free(&ts);
+    line_index_free(&li);
+    source_free(&src);
+}
+
+// Validates the whole input as UTF-8 with each set of kernels.
+static void bench_utf8(const char *path)
+{
+    Source src;
+    if (!source_open(&src, path)) PANIC("Cannot open %s: %m", path);
+
+    const char *best = scan.name;
+    const char *names[] = { "scalar", "sse2", "avx2" };
+    for (size_t i = 0; i < sizeof(names)/sizeof(*names); i++) {
+        if (!scan_use(names[i])) continue;
+        double start = now();
+        const char *bad = scan.find_invalid_utf8(src.data, src.data + src.len);
+        double secs = now() - start;
+
+        char name[16];
+        snprintf(name, sizeof(name), "utf8-%s", names[i]);
+        printf("%-10s %10zu bytes %9s  %8.3f s %9.2f MB/s\n", name, src.len,
+               bad == src.data + src.len ? "valid" : "invalid", secs, src.len / secs / 1e6);
+    }
+    scan_use(best);
+
+    source_free(&src);
+}
+
+// Lexes the mapped input once with each set of scanning kernels.
+static void bench_kernels(const char *path)
+{
+    Source src;
+    if (!source_open(&src, path)) PANIC("Cannot open %s: %m", path);
+
+    const char *best = scan.name;
+    const char *names[] = { "scalar", "sse2", "avx2" };
+    for (size_t i = 0; i < sizeof(names)/sizeof(*names); i++) {
+        if (!scan_use(names[i])) continue;
+        bench_lex(names[i], &src, now());
+    }
+    scan_use(best);
+
+    source_free(&src);
+}
+
+// next_token against the switch it replaces where computed goto is available.
+static void bench_dispatch(const char *path)
+{
+    Source src;
+    if (!source_open(&src, path)) PANIC("Cannot open %s: %m", path);
+
+#ifdef LEX_COMPUTED_GOTO
+    bench_lex_with("goto", &src, now(), next_token);
+#endif
+    bench_lex_with("switch", &src, now(), next_token_switch);
+
+    source_free(&src);
+}
+
+// next_token over the whole file, interning identifiers, repeated for at
+// least a quarter second; the fastest run is reported.  Runs in a child
+// process so that the peak RSS is this file's alone.
+static void bench_json(const char *path)
+{
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) PANIC("Cannot fork: %m");
+    if (pid) {
+        int status;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status)) PANIC("Benchmark of %s failed", path);
+        return;
+    }
+
+    Source src;
+    if (!source_open(&src, path)) PANIC("Cannot open %s: %m", path);
+
+    size_t tokens = 0, heap = 0;
+    double best = 1e300, total = 0;
+    uint64_t best_cycles = 0;
+    for (int run = 0; run < 3 || total < 0.25; run++) {
+        size_t before = heap_in_use();
+        double start = now();
+        uint64_t start_cycles = cycles();
+
+        Arena arena;
+        arena_init(&arena, 0);
+        Interner interner;
+        interner_init(&interner, &arena);
+        Lexer l;
+        lexer_init(&l, src.data, src.len, &arena, &interner);
+        tokens = 0;
+        while (next_token(&l).type != TOK_EOF) tokens++;
+        heap = heap_in_use() - before;
+        arena_free(&arena);
+
+        uint64_t run_cycles = cycles() - start_cycles;
+        double secs = now() - start;
+        total += secs;
+        if (secs < best) {
+            best = secs;
+            best_cycles = run_cycles;
+        }
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    printf("{\"file\": \"");
+    for (const char *p = path; *p; p++) printf(*p == '"' || *p == '\\' ? "\\%c" : "%c", *p);
+    printf("\", \"kernels\": \"%s\", \"bytes\": %zu, \"tokens\": %zu, \"seconds\": %.9f, "
+           "\"mb_per_s\": %.2f, \"tokens_per_s\": %.0f, \"cycles_per_byte\": %.3f, "
+           "\"heap_bytes\": %zu, \"peak_rss_kb\": %ld}\n",
+           scan.name, src.len, tokens, best, src.len / best / 1e6, tokens / best,
+           src.len ? (double)best_cycles / src.len : 0, heap, usage.ru_maxrss);
+    fflush(stdout);
+    _exit(0);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 3 && !strcmp(argv[1], "--json")) {
+        for (int i = 2; i < argc; i++) bench_json(argv[i]);
+        return 0;
+    }
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <file>\n       %s --json <file>...\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    FILE *f = fopen(argv[1], "r");
+    if (!f) PANIC("Cannot open %s: %m", argv[1]);
+    fseek(f, 0, SEEK_END);
+    size_t bytes = ftell(f);
+    fclose(f);
+
+    bench_legacy(argv[1], bytes);
+    bench_buffered(argv[1]);
+    bench_mapped(argv[1]);
+    bench_kernels(argv[1]);
+    bench_dispatch(argv[1]);
+    bench_lines(argv[1]);
+    bench_utf8(argv[1]);
+    bench_stream(argv[1]);
+    bench_parallel(argv[1]);
+    bench_independent(argv[1]);
+    bench_push(argv[1], 4 * 1024);
+    bench_push(argv[1], 64 * 1024);
+    bench_edits(argv[1]);
+    bench_emit(argv[1]);
+    bench_materialize(argv[1]);
+    bench_classify(argv[1]);
+    bench_numbers(argv[1]);
+
+    return 0;
+}
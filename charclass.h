@@ -0,0 +1,33 @@
+#ifndef CHARCLASS_H
+#define CHARCLASS_H
+
+#include <stdint.h>
+
+// Byte classes for the lexer.  The low bits are the kind next_token
+// dispatches on; the high bits say which runs a byte may continue.
+// Unlike <ctype.h> this does not depend on the locale and is defined for
+// every byte value.
+enum {
+    CC_NONE = 0,
+    CC_SPACE,
+    CC_IDENT_START,
+    CC_DIGIT,
+    CC_OP,
+    CC_QUOTE,
+    // Any byte outside ASCII.
+    CC_UTF8,
+    CC_KIND = 0x07,
+
+    CC_IDENT = 0x08,
+    CC_NUM = 0x10,
+    CC_HEX = 0x20,
+};
+
+extern const uint8_t char_class[256];
+
+#define char_kind(c) (char_class[(unsigned char)(c)] & CC_KIND)
+#define is_ident_char(c) (char_class[(unsigned char)(c)] & CC_IDENT)
+#define is_num_char(c) (char_class[(unsigned char)(c)] & CC_NUM)
+#define is_hex_char(c) (char_class[(unsigned char)(c)] & CC_HEX)
+
+#endif // CHARCLASS_H
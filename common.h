@@ -0,0 +1,19 @@
+#ifndef COMMON_H
+#define COMMON_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define _PRINT_MSG(prefix, ...) do {              \
+    printf(prefix" %s:%d ", __FILE__, __LINE__);  \
+    printf(__VA_ARGS__);                          \
+    printf("\n");                                 \
+} while(0);                                       \
+
+#define DBG(...) _PRINT_MSG("[DBG]", __VA_ARGS__)
+#define PANIC(...) do {                           \
+    _PRINT_MSG("[PANIC]", __VA_ARGS__);           \
+    exit(1);                                      \
+} while (0);
+
+#endif // COMMON_H
@@ -0,0 +1,182 @@
+// Generates a synthetic source file for benchmarking.  The output depends
+// only on the arguments, so a corpus can be regenerated anywhere instead of
+// being checked in.
+//
+//   gen_corpus <ident|comment|string|number|mixed|unicode> <size>[K|M|G] [seed]
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static uint64_t state;
+
+static uint64_t next_random(void)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+static unsigned pick(unsigned n)
+{
+    return next_random() % n;
+}
+
+#define WORDS 512
+static char words[WORDS][48];
+
+// Letters outside ASCII for the unicode kind, which is the mixed kind with
+// these in its names, strings and comments.
+static const char *letters[] = { "é", "ü", "ñ", "α", "λ", "ω", "д", "ж", "я", "東", "京", "語" };
+#define LETTER_COUNT (sizeof(letters)/sizeof(*letters))
+
+static const char *keywords[] = { "let", "var", "if", "else", "while", "for", "return", "print", "fun", "nil" };
+#define KEYWORD_COUNT (sizeof(keywords)/sizeof(*keywords))
+
+static void make_words(bool unicode)
+{
+    for (int i = 0; i < WORDS; i++) {
+        // Mostly short names, as in real code, with the odd long one.
+        int len = 1 + pick(6) + (pick(8) ? 0 : pick(9));
+        char *w = words[i];
+        for (int j = 0; j < len; j++) {
+            if (unicode && pick(2)) {
+                w = stpcpy(w, letters[pick(LETTER_COUNT)]);
+            } else {
+                *w++ = j && pick(6) == 0 ? "_0123456789"[pick(11)] : (char)('a' + pick(26));
+            }
+        }
+        *w = '\0';
+    }
+}
+
+static const char *word(void)
+{
+    return words[pick(WORDS)];
+}
+
+static int put_ident_line(char *out)
+{
+    int n = sprintf(out, "    %s %s = %s", keywords[pick(KEYWORD_COUNT)], word(), word());
+    for (int i = pick(6); i > 0; i--) n += sprintf(out + n, " %c %s", "+-="[pick(3)], word());
+    if (pick(4) == 0) n += sprintf(out + n, " (%s) { [%s] }", word(), word());
+    return n + sprintf(out + n, ";\n");
+}
+
+static int put_comment_only(char *out)
+{
+    int n = sprintf(out, "%s//", pick(3) ? "" : "    ");
+    for (int i = 3 + pick(12); i > 0; i--) n += sprintf(out + n, " %s", word());
+    return n + sprintf(out + n, "\n");
+}
+
+// Comments with the odd line of code between them.
+static int put_comment_line(char *out)
+{
+    return pick(5) ? put_comment_only(out) : put_ident_line(out);
+}
+
+static int put_string_line(char *out)
+{
+    char quote = pick(4) ? '"' : '\'';
+    int n = sprintf(out, "    print %c", quote);
+    for (int i = 2 + pick(14); i > 0; i--) {
+        n += sprintf(out + n, "%s%s", word(), pick(10) ? " " : "\\n");
+    }
+    return n + sprintf(out + n, "%c;\n", quote);
+}
+
+static int put_number(char *out)
+{
+    switch (pick(8)) {
+        case 0: return sprintf(out, "0x%llx", (unsigned long long)(next_random() >> (1 + pick(60))));
+        case 1: return sprintf(out, "0b%u%u%u%u", pick(2), pick(2), pick(2), pick(2));
+        case 2: return sprintf(out, "%u.%u", pick(1000), pick(100000));
+        case 3: return sprintf(out, "%u.%ue%c%u", pick(10), pick(1000), "+-"[pick(2)], pick(300));
+        case 4: return sprintf(out, "%llu", (unsigned long long)(next_random() >> (1 + pick(63))));
+        default: return sprintf(out, "%u", pick(1000));
+    }
+}
+
+static int put_number_line(char *out)
+{
+    int n = sprintf(out, "    let %s = ", word());
+    n += put_number(out + n);
+    for (int i = pick(5); i > 0; i--) {
+        n += sprintf(out + n, " %c ", "+-"[pick(2)]);
+        n += put_number(out + n);
+    }
+    return n + sprintf(out + n, ";\n");
+}
+
+static int put_mixed_line(char *out)
+{
+    switch (pick(10)) {
+        case 0: case 1: return put_comment_only(out);
+        case 2: case 3: return put_string_line(out);
+        case 4: case 5: return put_number_line(out);
+        default: return put_ident_line(out);
+    }
+}
+
+static size_t parse_size(const char *s)
+{
+    char *end;
+    size_t n = strtoull(s, &end, 10);
+    switch (*end) {
+        case 'G': n <<= 10; // fallthrough
+        case 'M': n <<= 10; // fallthrough
+        case 'K': n <<= 10; end++; break;
+    }
+    return *end ? 0 : n;
+}
+
+int main(int argc, char **argv)
+{
+    static const struct {
+        const char *name;
+        int (*put_line)(char *out);
+    } kinds[] = {
+        { "ident", put_ident_line },
+        { "comment", put_comment_line },
+        { "string", put_string_line },
+        { "number", put_number_line },
+        { "mixed", put_mixed_line },
+        { "unicode", put_mixed_line },
+    };
+
+    int (*put_line)(char *out) = NULL;
+    for (size_t i = 0; argc >= 3 && i < sizeof(kinds)/sizeof(*kinds); i++) {
+        if (!strcmp(argv[1], kinds[i].name)) put_line = kinds[i].put_line;
+    }
+    size_t size = argc >= 3 ? parse_size(argv[2]) : 0;
+    if (!put_line || !size || argc > 4) {
+        fprintf(stderr, "Usage: %s <ident|comment|string|number|mixed|unicode> <size>[K|M|G] [seed]\n", argv[0]);
+        return 1;
+    }
+    state = argc == 4 ? strtoull(argv[3], NULL, 10) : 0;
+    state = state * 0x9e3779b97f4a7c15ull + 88172645463325252ull;
+    make_words(!strcmp(argv[1], "unicode"));
+
+    // Whole lines only, so no token is cut off; the rest is newlines.
+    static char buf[1 << 16];
+    size_t used = 0, written = 0;
+    char line[1024];
+    for (;;) {
+        int n = put_line(line);
+        if (written + used + n > size) break;
+        if (used + n > sizeof(buf)) {
+            fwrite(buf, 1, used, stdout);
+            written += used;
+            used = 0;
+        }
+        memcpy(buf + used, line, n);
+        used += n;
+    }
+    fwrite(buf, 1, used, stdout);
+    for (written += used; written < size; written++) putchar('\n');
+    return ferror(stdout) ? 1 : 0;
+}
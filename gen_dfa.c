@@ -0,0 +1,220 @@
+// Generates dfa.gen.h: a minimized DFA for the punctuators and the line
+// comment in tokens.h.  Columns for bytes that every state treats the same
+// are merged into one class, and only states with transitions get a row.
+// States are numbered with 0 dead, then the ones with transitions, then the
+// ones without; the start state is folded into dfa_start.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tokens.h"
+
+#define PUNCT_TEXT(name, text) text,
+#define PUNCT_TYPE(name, text) "TOK_" #name,
+
+static const char *texts[] = { PUNCTUATORS(PUNCT_TEXT) LINE_COMMENT };
+static const char *types[] = { PUNCTUATORS(PUNCT_TYPE) "DFA_COMMENT" };
+
+#define COUNT (sizeof(texts)/sizeof(*texts))
+#define MAX_STATES 256
+
+// The trie of the patterns.  State 0 is dead and state 1 the start.
+static int next[MAX_STATES][256];
+static int accept[MAX_STATES];
+static int state_count = 2;
+
+static int block[MAX_STATES];
+
+static void add(const char *text, int type)
+{
+    int s = 1;
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++) {
+        if (!next[s][*p]) {
+            if (state_count == MAX_STATES) {
+                fprintf(stderr, "gen_dfa: too many states\n");
+                exit(1);
+            }
+            accept[state_count] = -1;
+            next[s][*p] = state_count++;
+        }
+        s = next[s][*p];
+    }
+    if (accept[s] >= 0) {
+        fprintf(stderr, "gen_dfa: \"%s\" is listed twice\n", text);
+        exit(1);
+    }
+    accept[s] = type;
+}
+
+static bool has_transitions(int s)
+{
+    for (int c = 0; c < 256; c++) {
+        if (next[s][c]) return true;
+    }
+    return false;
+}
+
+// Moore's algorithm: start from the states split by what they accept and
+// split blocks until no two states in one block go to different blocks.
+static int minimize(void)
+{
+    int blocks = 0;
+    for (int s = 0; s < state_count; s++) {
+        block[s] = -1;
+        for (int t = 0; t < s; t++) {
+            if (accept[t] == accept[s]) {
+                block[s] = block[t];
+                break;
+            }
+        }
+        if (block[s] < 0) block[s] = blocks++;
+    }
+
+    for (;;) {
+        int split[MAX_STATES];
+        int count = 0;
+        for (int s = 0; s < state_count; s++) {
+            split[s] = -1;
+            for (int t = 0; t < s && split[s] < 0; t++) {
+                if (block[t] != block[s]) continue;
+                bool same = true;
+                for (int c = 0; c < 256 && same; c++) same = block[next[s][c]] == block[next[t][c]];
+                if (same) split[s] = split[t];
+            }
+            if (split[s] < 0) split[s] = count++;
+        }
+        memcpy(block, split, sizeof(split));
+        if (count == blocks) return blocks;
+        blocks = count;
+    }
+}
+
+static void print_byte(int c)
+{
+    if (c == '\'' || c == '\\') {
+        printf("'\\%c'", c);
+    } else if (c >= ' ' && c < 0x7f) {
+        printf("'%c'", c);
+    } else {
+        printf("%d", c);
+    }
+}
+
+int main(void)
+{
+    accept[0] = accept[1] = -1;
+    for (size_t i = 0; i < COUNT; i++) add(texts[i], i);
+    int blocks = minimize();
+
+    int rep[MAX_STATES];
+    for (int s = state_count - 1; s >= 0; s--) rep[block[s]] = s;
+    for (int s = 2; s < state_count; s++) {
+        if (block[s] == block[1] || block[s] == block[0]) {
+            fprintf(stderr, "gen_dfa: a punctuator state is equivalent to the start or dead state\n");
+            return 1;
+        }
+    }
+
+    // Dead first, then the blocks with transitions, then the rest.
+    int numbers[MAX_STATES], block_at[MAX_STATES];
+    for (int b = 0; b < blocks; b++) numbers[b] = -1;
+    int states = 0;
+    block_at[states] = block[0];
+    numbers[block[0]] = states++;
+    for (int b = 0; b < blocks; b++) {
+        if (numbers[b] < 0 && b != block[1] && has_transitions(rep[b])) {
+            block_at[states] = b;
+            numbers[b] = states++;
+        }
+    }
+    int inner = states;
+    for (int b = 0; b < blocks; b++) {
+        if (numbers[b] < 0 && b != block[1]) {
+            block_at[states] = b;
+            numbers[b] = states++;
+        }
+    }
+
+    // Bytes whose column is the same in every state but the start share a
+    // class; class 0 is the bytes that none of them has a transition on.
+    int class[256], class_byte[256], classes = 0;
+    for (int c = 0; c < 256; c++) {
+        class[c] = -1;
+        for (int k = 0; k < classes && class[c] < 0; k++) {
+            bool same = true;
+            for (int b = 0; b < blocks && same; b++) {
+                if (b == block[1]) continue;
+                same = block[next[rep[b]][c]] == block[next[rep[b]][class_byte[k]]];
+            }
+            if (same) class[c] = k;
+        }
+        if (class[c] < 0) {
+            class_byte[classes] = c;
+            class[c] = classes++;
+        }
+    }
+
+    printf("// Generated by gen_dfa from tokens.h.  Do not edit.\n\n");
+    printf("#define DFA_PUNCT_COUNT %zu\n", COUNT - 1);
+    printf("#define DFA_STATES %d\n", states);
+    printf("#define DFA_INNER %d\n", inner);
+    printf("#define DFA_CLASSES %d\n", classes);
+    size_t max_len = 0;
+    for (size_t i = 0; i < COUNT; i++) {
+        if (strlen(texts[i]) > max_len) max_len = strlen(texts[i]);
+    }
+    printf("// The longest punctuator or comment opener.\n");
+    printf("#define DFA_MAX_LEN %zu\n", max_len);
+    printf("// What dfa_accept holds for LINE_COMMENT.\n");
+    printf("#define DFA_COMMENT _TOK_COUNT\n\n");
+
+    printf("// The bytes that start a punctuator or comment.\n");
+    printf("#define DFA_START_BYTES(X)");
+    for (int c = 0; c < 256; c++) {
+        if (!next[1][c]) continue;
+        printf(" X(");
+        print_byte(c);
+        printf(")");
+    }
+    printf("\n\n");
+
+    printf("// The state after each byte from the start state.\n");
+    printf("static const uint8_t dfa_start[256] = {\n");
+    for (int c = 0; c < 256; c++) {
+        if (!next[1][c]) continue;
+        printf("    [");
+        print_byte(c);
+        printf("] = %d,\n", numbers[block[next[1][c]]]);
+    }
+    printf("};\n\n");
+
+    printf("static const uint8_t dfa_class[256] = {\n");
+    for (int c = 0; c < 256; c++) {
+        if (!class[c]) continue;
+        printf("    [");
+        print_byte(c);
+        printf("] = %d,\n", class[c]);
+    }
+    printf("};\n\n");
+
+    printf("// Only the states below DFA_INNER have transitions.\n");
+    printf("static const uint8_t dfa_next[DFA_INNER][DFA_CLASSES] = {\n");
+    for (int n = 0; n < inner; n++) {
+        printf("    {");
+        for (int k = 0; k < classes; k++) {
+            printf(" %d,", numbers[block[next[rep[block_at[n]]][class_byte[k]]]]);
+        }
+        printf(" },\n");
+    }
+    printf("};\n\n");
+
+    printf("static const uint8_t dfa_accept[DFA_STATES] = {\n");
+    for (int n = 0; n < states; n++) {
+        int a = accept[rep[block_at[n]]];
+        printf("    %s,\n", a < 0 ? "TOK_ERROR" : types[a]);
+    }
+    printf("};\n");
+    return 0;
+}
@@ -0,0 +1,78 @@
+// Generates keywords.gen.h: a perfect hash over (length, first, last) for the
+// keywords in keywords.h.  The lexer classifies an identifier by hashing it
+// once and comparing against the single candidate in the slot.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "keywords.h"
+
+#define KEYWORD_TEXT(name, text) #text,
+#define KEYWORD_NAME(name, text) "TOK_" #name,
+
+static const char *texts[] = { KEYWORDS(KEYWORD_TEXT) };
+static const char *types[] = { KEYWORDS(KEYWORD_NAME) };
+
+#define COUNT (sizeof(texts)/sizeof(*texts))
+#define MAX_MUL 64
+
+static unsigned hash(const char *s, unsigned a, unsigned b, unsigned mask)
+{
+    size_t len = strlen(s);
+    return ((unsigned char)s[0] * a + (unsigned char)s[len - 1] * b + len) & mask;
+}
+
+static bool try_params(unsigned a, unsigned b, unsigned size)
+{
+    bool used[1024] = { 0 };
+    for (size_t i = 0; i < COUNT; i++) {
+        unsigned h = hash(texts[i], a, b, size - 1);
+        if (used[h]) return false;
+        used[h] = true;
+    }
+    return true;
+}
+
+int main(void)
+{
+    size_t max_len = 0;
+    for (size_t i = 0; i < COUNT; i++) {
+        if (strlen(texts[i]) > max_len) max_len = strlen(texts[i]);
+    }
+
+    for (unsigned size = 16; size <= 1024; size *= 2) {
+        if (size < COUNT) continue;
+        for (unsigned a = 1; a < MAX_MUL; a++) {
+            for (unsigned b = 0; b < MAX_MUL; b++) {
+                if (!try_params(a, b, size)) continue;
+
+                const char *slots[1024] = { 0 };
+                const char *slot_types[1024] = { 0 };
+                for (size_t i = 0; i < COUNT; i++) {
+                    unsigned h = hash(texts[i], a, b, size - 1);
+                    slots[h] = texts[i];
+                    slot_types[h] = types[i];
+                }
+
+                printf("// Generated by gen_keywords from keywords.h.  Do not edit.\n\n");
+                printf("#define KEYWORD_COUNT %zu\n", COUNT);
+                printf("#define KEYWORD_HASH_A %u\n", a);
+                printf("#define KEYWORD_HASH_B %u\n", b);
+                printf("#define KEYWORD_HASH_MASK %u\n", size - 1);
+                printf("#define KEYWORD_MAX_LEN %zu\n\n", max_len);
+                printf("static const struct {\n    char text[%zu];\n    uint8_t len;\n    uint8_t type;\n} keyword_slots[%u] = {\n",
+                       max_len + 1, size);
+                for (unsigned i = 0; i < size; i++) {
+                    if (!slots[i]) continue;
+                    printf("    [%u] = { \"%s\", %zu, %s },\n", i, slots[i], strlen(slots[i]), slot_types[i]);
+                }
+                printf("};\n");
+                return 0;
+            }
+        }
+    }
+
+    fprintf(stderr, "gen_keywords: no perfect hash found\n");
+    return 1;
+}
@@ -0,0 +1,152 @@
+// Generates pow5.gen.h: 128-bit approximations of 5^q for the decimal
+// exponents a double can reach, as used by the Eisel-Lemire conversion in
+// number.c.  For q >= 0 the value is 5^q truncated to its top 128 bits; for
+// q < 0 it is 2^b / 5^-q rounded up, scaled to 128 bits.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define SMALLEST_POWER -342
+#define LARGEST_POWER 308
+#define LIMBS 80
+
+typedef struct {
+    uint32_t d[LIMBS];
+} Big;
+
+static void big_set(Big *a, uint32_t v)
+{
+    memset(a, 0, sizeof(*a));
+    a->d[0] = v;
+}
+
+static void big_mul_small(Big *a, uint32_t m)
+{
+    uint64_t carry = 0;
+    for (int i = 0; i < LIMBS; i++) {
+        uint64_t v = (uint64_t)a->d[i] * m + carry;
+        a->d[i] = (uint32_t)v;
+        carry = v >> 32;
+    }
+}
+
+static int big_bits(const Big *a)
+{
+    for (int i = LIMBS - 1; i >= 0; i--) {
+        if (a->d[i]) return i * 32 + 32 - __builtin_clz(a->d[i]);
+    }
+    return 0;
+}
+
+static void big_set_bit(Big *a, int i)
+{
+    a->d[i / 32] |= 1u << (i % 32);
+}
+
+static void big_shl1(Big *a)
+{
+    for (int i = LIMBS - 1; i > 0; i--) a->d[i] = (a->d[i] << 1) | (a->d[i - 1] >> 31);
+    a->d[0] <<= 1;
+}
+
+static void big_shr(Big *a, int n)
+{
+    for (; n > 0; n--) {
+        for (int i = 0; i < LIMBS - 1; i++) a->d[i] = (a->d[i] >> 1) | (a->d[i + 1] << 31);
+        a->d[LIMBS - 1] >>= 1;
+    }
+}
+
+static int big_cmp(const Big *a, const Big *b)
+{
+    for (int i = LIMBS - 1; i >= 0; i--) {
+        if (a->d[i] != b->d[i]) return a->d[i] < b->d[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+static void big_sub(Big *a, const Big *b)
+{
+    int64_t borrow = 0;
+    for (int i = 0; i < LIMBS; i++) {
+        int64_t v = (int64_t)a->d[i] - b->d[i] - borrow;
+        borrow = v < 0;
+        a->d[i] = (uint32_t)v;
+    }
+}
+
+static void big_add_small(Big *a, uint32_t v)
+{
+    for (int i = 0; i < LIMBS && v; i++) {
+        uint64_t s = (uint64_t)a->d[i] + v;
+        a->d[i] = (uint32_t)s;
+        v = s >> 32;
+    }
+}
+
+// q = floor(2^b / p), by binary long division.
+static void big_div_pow2(Big *q, int b, const Big *p)
+{
+    Big r;
+    big_set(&r, 0);
+    big_set(q, 0);
+    for (int i = b; i >= 0; i--) {
+        big_shl1(&r);
+        if (i == b) r.d[0] |= 1;
+        if (big_cmp(&r, p) >= 0) {
+            big_sub(&r, p);
+            big_set_bit(q, i);
+        }
+    }
+}
+
+static void emit(const Big *c, int q)
+{
+    uint64_t hi = (uint64_t)c->d[3] << 32 | c->d[2];
+    uint64_t lo = (uint64_t)c->d[1] << 32 | c->d[0];
+    printf("    0x%016llx, 0x%016llx, // 5^%d\n", (unsigned long long)hi, (unsigned long long)lo, q);
+}
+
+int main(void)
+{
+    printf("// Generated by gen_pow5.  Do not edit.\n\n");
+    printf("#define POW5_SMALLEST %d\n", SMALLEST_POWER);
+    printf("#define POW5_LARGEST %d\n\n", LARGEST_POWER);
+    printf("static const uint64_t pow5_128[] = {\n");
+
+    for (int q = SMALLEST_POWER; q < 0; q++) {
+        Big p;
+        big_set(&p, 1);
+        for (int i = 0; i < -q; i++) big_mul_small(&p, 5);
+
+        // z is the number of bits needed for 5^-q rounded up to a power of two.
+        int z = big_bits(&p);
+        Big pow2;
+        big_set(&pow2, 0);
+        big_set_bit(&pow2, z - 1);
+        if (big_cmp(&pow2, &p) == 0) z--;
+
+        int b = q >= -27 ? z + 127 : 2 * z + 128;
+        Big c;
+        big_div_pow2(&c, b, &p);
+        big_add_small(&c, 1);
+        int bits = big_bits(&c);
+        if (bits > 128) big_shr(&c, bits - 128);
+        emit(&c, q);
+    }
+
+    for (int q = 0; q <= LARGEST_POWER; q++) {
+        Big p;
+        big_set(&p, 1);
+        for (int i = 0; i < q; i++) big_mul_small(&p, 5);
+
+        int bits = big_bits(&p);
+        if (bits > 128) big_shr(&p, bits - 128);
+        else for (; bits < 128; bits++) big_shl1(&p);
+        emit(&p, q);
+    }
+
+    printf("};\n");
+    return 0;
+}
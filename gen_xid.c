@@ -0,0 +1,89 @@
+// Generates xid.gen.h: two-level bitmaps for the XID_Start and XID_Continue
+// ranges in unicode_xid.h.  Code points are split into chunks of 512, each
+// stored once as eight 64-bit words however often it occurs, and a byte per
+// chunk of each property picks its bitmap.  Past the last index entry the
+// property is false.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "unicode_xid.h"
+
+#define CHUNK_BITS 9
+#define CHUNK (1 << CHUNK_BITS)
+#define MAX_CODE_POINT 0x10ffff
+#define MAX_CHUNKS 256
+
+typedef struct {
+    uint32_t first, last;
+} Range;
+
+#define RANGE(first, last) { first, last },
+static const Range start_ranges[] = { XID_START_RANGES(RANGE) };
+static const Range continue_ranges[] = { XID_CONTINUE_RANGES(RANGE) };
+
+static uint64_t chunks[MAX_CHUNKS][CHUNK / 64];
+static int chunk_count = 1;
+
+// Fills `index` for the property and returns its length.
+static int build(const Range *ranges, size_t count, uint8_t *index)
+{
+    static uint64_t bits[(MAX_CODE_POINT + 1) / 64];
+    memset(bits, 0, sizeof(bits));
+    uint32_t top = 0;
+    for (size_t i = 0; i < count; i++) {
+        for (uint32_t c = ranges[i].first; c <= ranges[i].last; c++) bits[c / 64] |= 1ull << (c % 64);
+        if (ranges[i].last > top) top = ranges[i].last;
+    }
+
+    int len = top / CHUNK + 1;
+    for (int b = 0; b < len; b++) {
+        const uint64_t *chunk = bits + b * (CHUNK / 64);
+        int k = 0;
+        while (k < chunk_count && memcmp(chunks[k], chunk, sizeof(*chunks))) k++;
+        if (k == chunk_count) {
+            if (chunk_count == MAX_CHUNKS) {
+                fprintf(stderr, "gen_xid: more than %d distinct chunks\n", MAX_CHUNKS);
+                return -1;
+            }
+            memcpy(chunks[chunk_count++], chunk, sizeof(*chunks));
+        }
+        index[b] = k;
+    }
+    return len;
+}
+
+static void print_index(const char *name, const char *len_name, const uint8_t *index, int len)
+{
+    printf("#define %s %d\n", len_name, len);
+    printf("static const uint8_t %s[%s] = {", name, len_name);
+    for (int i = 0; i < len; i++) printf("%s%d,", i % 16 ? " " : "\n    ", index[i]);
+    printf("\n};\n\n");
+}
+
+int main(void)
+{
+    static uint8_t start_index[(MAX_CODE_POINT + 1) / CHUNK];
+    static uint8_t continue_index[(MAX_CODE_POINT + 1) / CHUNK];
+    int start_len = build(start_ranges, sizeof(start_ranges)/sizeof(*start_ranges), start_index);
+    int continue_len = build(continue_ranges, sizeof(continue_ranges)/sizeof(*continue_ranges), continue_index);
+    if (start_len < 0 || continue_len < 0) return 1;
+
+    printf("// Generated by gen_xid from unicode_xid.h.  Do not edit.\n\n");
+    printf("#define XID_CHUNK_BITS %d\n\n", CHUNK_BITS);
+    print_index("xid_start_index", "XID_START_LEN", start_index, start_len);
+    print_index("xid_continue_index", "XID_CONTINUE_LEN", continue_index, continue_len);
+
+    printf("static const uint64_t xid_chunks[%d][%d] = {\n", chunk_count, CHUNK / 64);
+    for (int k = 0; k < chunk_count; k++) {
+        printf("    {");
+        for (int w = 0; w < CHUNK / 64; w++) {
+            printf("%s0x%016llx,", w == 4 ? "\n     " : " ", (unsigned long long)chunks[k][w]);
+        }
+        printf(" },\n");
+    }
+    printf("};\n");
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include "intern.h"
+
+#include <string.h>
+
+#define INTERN_INITIAL_CAP 1024
+
+static uint32_t hash_bytes(const char *s, size_t len)
+{
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)s[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static InternSlot *alloc_slots(Arena *arena, uint32_t cap)
+{
+    InternSlot *slots = arena_alloc(arena, cap * sizeof(*slots));
+    for (uint32_t i = 0; i < cap; i++) slots[i].id = INTERN_NONE;
+    return slots;
+}
+
+void interner_init(Interner *in, Arena *arena)
+{
+    *in = (Interner) {
+        .arena = arena,
+        .slots = alloc_slots(arena, INTERN_INITIAL_CAP),
+        .cap = INTERN_INITIAL_CAP,
+        .entries = arena_alloc(arena, INTERN_INITIAL_CAP / 2 * sizeof(InternEntry)),
+        .entries_cap = INTERN_INITIAL_CAP / 2,
+    };
+}
+
+// The old arrays stay behind in the arena; since both double, the waste is
+// bounded by the final size.
+static void interner_grow(Interner *in)
+{
+    uint32_t cap = in->cap * 2;
+    InternSlot *slots = alloc_slots(in->arena, cap);
+    for (uint32_t i = 0; i < in->count; i++) {
+        uint32_t j = in->entries[i].hash & (cap - 1);
+        while (slots[j].id != INTERN_NONE) j = (j + 1) & (cap - 1);
+        slots[j] = (InternSlot){ in->entries[i].hash, i };
+    }
+    in->slots = slots;
+    in->cap = cap;
+
+    InternEntry *entries = arena_alloc(in->arena, cap / 2 * sizeof(*entries));
+    memcpy(entries, in->entries, in->count * sizeof(*entries));
+    in->entries = entries;
+    in->entries_cap = cap / 2;
+}
+
+static uint32_t probe(const Interner *in, const char *s, size_t len, uint32_t hash)
+{
+    uint32_t mask = in->cap - 1;
+    uint32_t i = hash & mask;
+    for (;; i = (i + 1) & mask) {
+        InternSlot slot = in->slots[i];
+        if (slot.id == INTERN_NONE) return i;
+
+        const InternEntry *e = &in->entries[slot.id];
+        if (slot.hash == hash && e->len == len && !memcmp(e->str, s, len)) return i;
+    }
+}
+
+uint32_t intern(Interner *in, const char *s, size_t len)
+{
+    uint32_t hash = hash_bytes(s, len);
+    uint32_t i = probe(in, s, len, hash);
+    if (in->slots[i].id != INTERN_NONE) {
+        in->hits++;
+        return in->slots[i].id;
+    }
+
+    in->misses++;
+    if (in->count >= in->entries_cap) {
+        interner_grow(in);
+        i = probe(in, s, len, hash);
+    }
+
+    char *str = arena_alloc(in->arena, len + 1);
+    memcpy(str, s, len);
+    str[len] = '\0';
+
+    uint32_t id = in->count++;
+    in->entries[id] = (InternEntry){ str, len, hash };
+    in->slots[i] = (InternSlot){ hash, id };
+    return id;
+}
+
+uint32_t intern_find(const Interner *in, const char *s, size_t len)
+{
+    return in->slots[probe(in, s, len, hash_bytes(s, len))].id;
+}
+
+const char *interner_str(const Interner *in, uint32_t id)
+{
+    return in->entries[id].str;
+}
+
+double interner_load(const Interner *in)
+{
+    return (double)in->count / in->cap;
+}
+
+void interner_print_stats(const Interner *in, FILE *f)
+{
+    fprintf(f, "intern: %u strings, %zu hits, %zu misses, load %.2f\n",
+            in->count, in->hits, in->misses, interner_load(in));
+}
@@ -0,0 +1,44 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "arena.h"
+
+typedef struct {
+    const char *str;
+    uint32_t len;
+    uint32_t hash;
+} InternEntry;
+
+typedef struct {
+    uint32_t hash;
+    uint32_t id;
+} InternSlot;
+
+// Maps each distinct string to a dense id and a stable NUL-terminated copy,
+// so later stages can compare names by id or pointer.  Open addressing with
+// linear probing; all storage comes from the arena.
+typedef struct {
+    Arena *arena;
+    InternSlot *slots;
+    uint32_t cap;
+    InternEntry *entries;
+    uint32_t count;
+    uint32_t entries_cap;
+    size_t hits;
+    size_t misses;
+} Interner;
+
+#define INTERN_NONE UINT32_MAX
+
+void interner_init(Interner *in, Arena *arena);
+uint32_t intern(Interner *in, const char *s, size_t len);
+uint32_t intern_find(const Interner *in, const char *s, size_t len);
+const char *interner_str(const Interner *in, uint32_t id);
+double interner_load(const Interner *in);
+void interner_print_stats(const Interner *in, FILE *f);
+
+#endif // INTERN_H
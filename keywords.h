@@ -0,0 +1,26 @@
+#ifndef KEYWORDS_H
+#define KEYWORDS_H
+
+// The single list of keywords.  It expands into the keyword members of
+// TokenType, their names[] entries, and (via gen_keywords) the perfect hash
+// used by the lexer.  X(NAME, text)
+#define KEYWORDS(X)    \
+    X(LET, let)        \
+    X(AND, and)        \
+    X(CLASS, class)    \
+    X(ELSE, else)      \
+    X(FALSE, false)    \
+    X(FOR, for)        \
+    X(FUN, fun)        \
+    X(IF, if)          \
+    X(NIL, nil)        \
+    X(OR, or)          \
+    X(PRINT, print)    \
+    X(RETURN, return)  \
+    X(SUPER, super)    \
+    X(THIS, this)      \
+    X(TRUE, true)      \
+    X(VAR, var)        \
+    X(WHILE, while)    \
+
+#endif // KEYWORDS_H
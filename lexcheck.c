@@ -0,0 +1,350 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "lexer.h"
+#include "lines.h"
+#include "parallel.h"
+#include "push.h"
+#include "relex.h"
+#include "scan.h"
+#include "source.h"
+#include "tokbin.h"
+
+// Lexes each file given in every other way there is and checks that the
+// tokens come out the same as lex_all's, with the best kernels or the
+// scalar ones.  Prints each difference and exits
+// with 1 if there was any; `make check` runs it over the small corpora.
+
+static size_t checks, failures;
+
+static void check(bool ok, const char *path, const char *what)
+{
+    checks++;
+    if (ok) return;
+    failures++;
+    printf("%s: %s MISMATCH\n", path, what);
+}
+
+static bool same_stream(const TokenStream *a, const TokenStream *b)
+{
+    if (a->count != b->count || a->value_count != b->value_count) return false;
+    if (memcmp(a->types, b->types, a->count * sizeof(*a->types))) return false;
+    if (memcmp(a->offsets, b->offsets, a->count * sizeof(*a->offsets))) return false;
+    if (memcmp(a->lens, b->lens, a->count * sizeof(*a->lens))) return false;
+
+    size_t value = 0;
+    for (size_t i = 0; i < a->count; i++) {
+        if (!token_has_value(a->types[i])) continue;
+        TokenValue x = a->values[value], y = b->values[value];
+        value++;
+        switch (a->types[i]) {
+            case TOK_NUMBER: if (x.number_value != y.number_value) return false; break;
+            case TOK_FLOAT: if (memcmp(&x.float_value, &y.float_value, sizeof(double))) return false; break;
+            case TOK_IDENT: if (x.ident != y.ident) return false; break;
+            case TOK_STRING: if (x.has_escapes != y.has_escapes) return false; break;
+            case TOK_ERROR: if (x.error != y.error) return false; break;
+            default: break;
+        }
+    }
+    return true;
+}
+
+// lex_all_parallel with interning, so that identifier ids are compared too.
+static void check_parallel(const char *path, const char *data, size_t len)
+{
+    static const int threads[] = { 1, 2, 3, 4, 8 };
+
+    Arena arena;
+    arena_init(&arena, 0);
+    Interner interner;
+    interner_init(&interner, &arena);
+    Lexer l;
+    lexer_init(&l, data, len, &arena, &interner);
+    TokenStream expect = { 0 };
+    lex_all(&l, &expect);
+    size_t errors = l.error_count;
+    arena_free(&arena);
+
+    for (size_t i = 0; i < sizeof(threads) / sizeof(*threads); i++) {
+        arena_init(&arena, 0);
+        interner_init(&interner, &arena);
+        lexer_init(&l, data, len, &arena, &interner);
+        TokenStream ts = { 0 };
+        lex_all_parallel(&l, &ts, threads[i]);
+
+        char what[32];
+        snprintf(what, sizeof(what), "parallel %d", threads[i]);
+        check(same_stream(&ts, &expect) && l.error_count == errors, path, what);
+
+        token_stream_free(&ts);
+        arena_free(&arena);
+    }
+    token_stream_free(&expect);
+}
+
+// The push lexer fed pieces of a few sizes, down to single bytes.
+static void check_push(const char *path, const char *data, size_t len)
+{
+    static const size_t pieces[] = { 1, 13, 4096, 65536 };
+
+    Lexer l;
+    lexer_init(&l, data, len, NULL, NULL);
+    TokenStream expect = { 0 };
+    lex_all(&l, &expect);
+
+    for (size_t i = 0; i < sizeof(pieces) / sizeof(*pieces); i++) {
+        PushLexer p;
+        push_lexer_init(&p, NULL, NULL);
+        TokenStream ts = { 0 };
+        bool ok = true;
+        size_t at = 0;
+        do {
+            size_t n = len - at < pieces[i] ? len - at : pieces[i];
+            ok = push_lexer_feed(&p, data + at, n, at + n == len, &ts);
+            at += n;
+        } while (ok && at < len);
+
+        char what[32];
+        snprintf(what, sizeof(what), "push %zu", pieces[i]);
+        check(ok && same_stream(&ts, &expect) && p.lexer.error_count == l.error_count, path, what);
+
+        push_lexer_free(&p);
+        token_stream_free(&ts);
+    }
+    token_stream_free(&expect);
+}
+
+// The line index built with each set of kernels, against lines and columns
+// counted a byte at a time up to each token.
+static void check_lines(const char *path, const char *data, size_t len)
+{
+    Lexer l;
+    lexer_init(&l, data, len, NULL, NULL);
+    TokenStream ts = { 0 };
+    lex_all(&l, &ts);
+
+    const char *best = scan.name;
+    const char *names[] = { "scalar", "sse2", "avx2" };
+    for (size_t i = 0; i < sizeof(names) / sizeof(*names); i++) {
+        if (!scan_use(names[i])) continue;
+        LineIndex li;
+        bool ok = line_index_build(&li, data, len);
+
+        uint32_t line = 1;
+        size_t at = 0, line_start = 0;
+        for (size_t k = 0; ok && k < ts.count; k++) {
+            for (; at < ts.offsets[k]; at++) {
+                if (data[at] != '\n') continue;
+                line++;
+                line_start = at + 1;
+            }
+            uint32_t got_line, got_col;
+            line_index_find(&li, ts.offsets[k], &got_line, &got_col);
+            ok = got_line == line && got_col == ts.offsets[k] - line_start + 1;
+        }
+
+        char what[32];
+        snprintf(what, sizeof(what), "lines %s", names[i]);
+        check(ok, path, what);
+        line_index_free(&li);
+    }
+    scan_use(best);
+    token_stream_free(&ts);
+}
+
+// The stream with interned ids written in the binary format to a file and
+// loaded back.
+static void check_tokbin(const char *path, const char *data, size_t len)
+{
+    Arena arena;
+    arena_init(&arena, 0);
+    Interner interner;
+    interner_init(&interner, &arena);
+    Lexer l;
+    lexer_init(&l, data, len, &arena, &interner);
+    TokenStream ts = { 0 };
+    lex_all(&l, &ts);
+
+    char tmp[] = "/tmp/lexcheck-tokens-XXXXXX";
+    int fd = mkstemp(tmp);
+    if (fd < 0 || !tokbin_write(fd, &ts)) PANIC("Cannot write %s: %m", tmp);
+    close(fd);
+
+    TokenStream back = { 0 };
+    check(tokbin_load(tmp, &back) && same_stream(&ts, &back), path, "tokens-bin");
+    unlink(tmp);
+
+    token_stream_free(&back);
+    token_stream_free(&ts);
+    arena_free(&arena);
+}
+
+// lex_all and UTF-8 validation with each set of kernels against the scalar
+// ones.
+static void check_kernels(const char *path, const char *data, size_t len)
+{
+    const char *best = scan.name;
+    const char *names[] = { "sse2", "avx2" };
+    scan_use("scalar");
+    Lexer l;
+    lexer_init(&l, data, len, NULL, NULL);
+    TokenStream expect = { 0 };
+    lex_all(&l, &expect);
+    const char *invalid = scan.find_invalid_utf8(data, data + len);
+
+    for (size_t i = 0; i < sizeof(names) / sizeof(*names); i++) {
+        if (!scan_use(names[i])) continue;
+        lexer_init(&l, data, len, NULL, NULL);
+        TokenStream ts = { 0 };
+        lex_all(&l, &ts);
+
+        char what[32];
+        snprintf(what, sizeof(what), "lex_all %s", names[i]);
+        check(same_stream(&ts, &expect), path, what);
+        snprintf(what, sizeof(what), "utf8 %s", names[i]);
+        check(scan.find_invalid_utf8(data, data + len) == invalid, path, what);
+        token_stream_free(&ts);
+    }
+    scan_use(best);
+    token_stream_free(&expect);
+}
+
+static void check_text(const char *path, const char *data, size_t len)
+{
+    check_parallel(path, data, len);
+    check_push(path, data, len);
+    check_lines(path, data, len);
+    check_tokbin(path, data, len);
+    check_kernels(path, data, len);
+}
+
+static void apply_edit(char *text, size_t *len, size_t offset, size_t removed, const char *inserted, size_t n)
+{
+    memmove(text + offset + n, text + offset + removed, *len - offset - removed);
+    memcpy(text + offset, inserted, n);
+    *len += n - removed;
+}
+
+static bool relexed_right(const RelexStream *rs, const char *text, size_t len)
+{
+    Lexer l;
+    lexer_init(&l, text, len, NULL, NULL);
+    TokenStream ts = { 0 }, expect = { 0 };
+    relex_stream_tokens(rs, &ts);
+    lex_all(&l, &expect);
+    bool same = same_stream(&ts, &expect);
+    token_stream_free(&expect);
+    token_stream_free(&ts);
+    return same;
+}
+
+// Edits after which relex once disagreed with lex_all.
+static const struct {
+    const char *text;
+    size_t offset, removed;
+    const char *inserted;
+} relex_cases[] = {
+    // The last byte of a character decides where the identifier before it ends.
+    { "a\xF0\x9D\x91\x95 b", 4, 1, "\x94" },
+};
+
+static void check_relex_cases(void)
+{
+    for (size_t i = 0; i < sizeof(relex_cases) / sizeof(*relex_cases); i++) {
+        size_t len = strlen(relex_cases[i].text), n = strlen(relex_cases[i].inserted);
+        char *text = malloc(len + n);
+        if (!text) PANIC("Out of memory");
+        memcpy(text, relex_cases[i].text, len);
+
+        Lexer l;
+        lexer_init(&l, text, len, NULL, NULL);
+        RelexStream rs;
+        relex_stream_init(&rs, &l);
+        apply_edit(text, &len, relex_cases[i].offset, relex_cases[i].removed, relex_cases[i].inserted, n);
+        lexer_init(&l, text, len, NULL, NULL);
+        relex(&l, &rs, relex_cases[i].offset, relex_cases[i].removed, n);
+
+        char what[32];
+        snprintf(what, sizeof(what), "relex case %zu", i + 1);
+        check(relexed_right(&rs, text, len), "lexcheck.c", what);
+
+        relex_stream_free(&rs);
+        free(text);
+    }
+}
+
+// Random edits, mostly a few bytes from the previous one as when typing,
+// of bytes that open and close tokens or break UTF-8.  The stream is
+// compared with lex_all every 100 edits.  The edited text, which is full
+// of errors, is then checked in the other ways too.
+static void check_relex(const char *path, const char *data, size_t len)
+{
+    static const char bytes[] = "\"'\\\n/*.e+-0x1_a \xF0\x9D\x91\x95\xC3";
+    enum { EDITS = 2000, MAX_INSERT = 2 };
+
+    char *text = malloc(len + EDITS * MAX_INSERT);
+    if (!text) PANIC("Out of memory");
+    memcpy(text, data, len);
+
+    Lexer l;
+    lexer_init(&l, text, len, NULL, NULL);
+    RelexStream rs;
+    relex_stream_init(&rs, &l);
+
+    bool ok = true;
+    size_t at = 0;
+    uint64_t seed = 88172645463325252ull;
+    for (int i = 0; i < EDITS; i++) {
+        seed ^= seed << 13, seed ^= seed >> 7, seed ^= seed << 17;
+        if (i % 64 == 0) {
+            at = seed % (len + 1);
+        } else {
+            size_t step = seed % 7;
+            at = at + step < 3 ? 0 : at + step - 3;
+        }
+        if (at > len) at = len;
+        size_t removed = (seed >> 8) % 3;
+        if (removed > len - at) removed = len - at;
+        size_t n = (seed >> 16) % (MAX_INSERT + 1);
+        char inserted[MAX_INSERT];
+        for (size_t k = 0; k < n; k++) inserted[k] = bytes[(seed >> (24 + 8 * k)) % (sizeof(bytes) - 1)];
+
+        apply_edit(text, &len, at, removed, inserted, n);
+        lexer_init(&l, text, len, NULL, NULL);
+        relex(&l, &rs, at, removed, n);
+        if (i % 100 == 99) ok &= relexed_right(&rs, text, len);
+    }
+    check(ok, path, "relex");
+
+    char edited[256];
+    snprintf(edited, sizeof(edited), "%s, edited", path);
+    check_text(edited, text, len);
+
+    relex_stream_free(&rs);
+    free(text);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <file>...\n", argv[0]);
+        return 1;
+    }
+
+    check_relex_cases();
+    for (int i = 1; i < argc; i++) {
+        Source src;
+        if (!source_open(&src, argv[i])) PANIC("Cannot open %s: %m", argv[i]);
+        check_text(argv[i], src.data, src.len);
+        check_relex(argv[i], src.data, src.len);
+        source_free(&src);
+    }
+
+    printf("%zu checks, %zu failed\n", checks, failures);
+    return failures != 0;
+}
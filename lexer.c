@@ -0,0 +1,652 @@
+#include "lexer.h"
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "charclass.h"
+#include "common.h"
+#include "dfa.gen.h"
+#include "keywords.gen.h"
+#include "number.h"
+#include "scan.h"
+#include "utf8.h"
+
+char *names[] = {
+    [TOK_EOF] = "EOF",
+    [TOK_ERROR] = "ERROR",
+#define PUNCT_NAME(name, text) [TOK_##name] = text,
+    PUNCTUATORS(PUNCT_NAME)
+#undef PUNCT_NAME
+    [TOK_NUMBER] = "NUMBER",
+    [TOK_FLOAT] = "FLOAT",
+    [TOK_IDENT] = "IDENT",
+    [TOK_STRING] = "STRING",
+#define KEYWORD_NAME(name, text) [TOK_##name] = #name,
+    KEYWORDS(KEYWORD_NAME)
+#undef KEYWORD_NAME
+};
+
+static_assert(sizeof(names)/sizeof(*names) == _TOK_COUNT, "Not every token is named");
+
+#define KEYWORD_ONE(name, text) 1 +
+static_assert(KEYWORDS(KEYWORD_ONE) 0 == KEYWORD_COUNT, "keywords.gen.h is out of date");
+#undef KEYWORD_ONE
+
+#define PUNCT_ONE(name, text) 1 +
+static_assert(PUNCTUATORS(PUNCT_ONE) 0 == DFA_PUNCT_COUNT, "dfa.gen.h is out of date");
+#undef PUNCT_ONE
+
+// Classifies an identifier with one hash of its length and first and last
+// characters, and one compare against the only keyword that can match.
+TokenType ident_to_token_type(const char *ident, size_t len)
+{
+    if (len > KEYWORD_MAX_LEN) return TOK_IDENT;
+
+    unsigned h = ((unsigned char)ident[0] * KEYWORD_HASH_A
+                  + (unsigned char)ident[len - 1] * KEYWORD_HASH_B
+                  + len) & KEYWORD_HASH_MASK;
+    if (keyword_slots[h].len == len && !memcmp(ident, keyword_slots[h].text, len)) {
+        return keyword_slots[h].type;
+    }
+    return TOK_IDENT;
+}
+
+void lexer_init(Lexer *l, const char *data, size_t len, Arena *arena, Interner *interner)
+{
+    l->start = data;
+    l->cur = data;
+    l->end = data + len;
+    l->arena = arena;
+    l->interner = interner;
+    l->error_count = 0;
+    l->unclosed[0] = l->unclosed[1] = NULL;
+    l->utf8_begin = l->utf8_end = data;
+#ifdef LEX_STATS
+    l->stats = (LexStats){ 0 };
+#endif
+}
+
+const uint8_t char_class[256] = {
+    [' '] = CC_SPACE, ['\t'] = CC_SPACE, ['\n'] = CC_SPACE,
+    ['\v'] = CC_SPACE, ['\f'] = CC_SPACE, ['\r'] = CC_SPACE,
+    ['a' ... 'f'] = CC_IDENT_START | CC_IDENT | CC_HEX,
+    ['A' ... 'F'] = CC_IDENT_START | CC_IDENT | CC_HEX,
+    ['g' ... 'z'] = CC_IDENT_START | CC_IDENT,
+    ['G' ... 'Z'] = CC_IDENT_START | CC_IDENT,
+    ['_'] = CC_IDENT_START | CC_IDENT | CC_NUM | CC_HEX,
+    ['0' ... '9'] = CC_DIGIT | CC_IDENT | CC_NUM | CC_HEX,
+#define PUNCT_CLASS(c) [c] = CC_OP,
+    DFA_START_BYTES(PUNCT_CLASS)
+#undef PUNCT_CLASS
+    ['\''] = CC_QUOTE, ['"'] = CC_QUOTE,
+    [0x80 ... 0xff] = CC_UTF8,
+};
+
+#ifdef LEX_STATS
+#define STAT(l, counter, n) ((l)->stats.counter += (n))
+#else
+#define STAT(l, counter, n) ((void)0)
+#endif
+
+static Token make_tok(Lexer *l, TokenType type, const char *begin, const char *end)
+{
+    return (Token) {
+        .type = type,
+        .len = end - begin,
+        .offset = begin - l->start,
+    };
+}
+
+// Errors become TOK_ERROR tokens over the bad bytes, and lexing goes on
+// after them.
+static Token error_tok(Lexer *l, DiagnosticCode code, const char *begin, const char *end)
+{
+    l->cur = end;
+    l->error_count++;
+    Token tok = make_tok(l, TOK_ERROR, begin, end);
+    tok.value.error = code;
+    return tok;
+}
+
+#define UTF8_BLOCK (64 * 1024)
+
+// `p` is at a byte outside ASCII in a string or a comment.  Returns the end
+// of the valid UTF-8 from there up to the next ASCII byte, which is `p` if
+// it does not start a character.  Validation runs ahead a block at a time,
+// so many short runs do not each pay for a call into the kernel.
+static const char *skip_utf8(Lexer *l, const char *p)
+{
+    if (p < l->utf8_begin || p >= l->utf8_end) {
+        const char *to = l->end - p > UTF8_BLOCK ? p + UTF8_BLOCK : l->end;
+        // A block ends before a character, so that the next starts at one.
+        while (to > p + 1 && to < l->end && (*to & 0xc0) == 0x80) to--;
+        l->utf8_begin = p;
+        l->utf8_end = scan.find_invalid_utf8(p, to);
+    }
+    while (p < l->utf8_end && (*p & 0x80)) p++;
+    return p;
+}
+
+// Moves past the rest of a line comment from `p`.  Returns false if it is
+// not UTF-8.
+static bool skip_comment(Lexer *l, const char *p)
+{
+    bool valid = true;
+    for (;;) {
+        p = scan.find_comment_end(p, l->end);
+        if (p >= l->end || *p == '\n') break;
+        const char *q = skip_utf8(l, p);
+        valid &= q > p;
+        p = q > p ? q : p + 1;
+    }
+    l->cur = p;
+    return valid;
+}
+
+// Identifier characters from `p` on, outside ASCII too.
+static const char *skip_ident_utf8(const char *p, const char *end)
+{
+    uint32_t cp;
+    for (;;) {
+        p = scan.skip_ident(p, end);
+        if (p >= end || !(*p & 0x80)) return p;
+        size_t n = utf8_decode(p, end, &cp);
+        if (!n || !is_xid_continue(cp)) return p;
+        p += n;
+    }
+}
+
+static Token ident_tok(Lexer *l, const char *begin, const char *end)
+{
+    l->cur = end;
+    STAT(l, word_bytes, end - begin);
+
+    Token tok = make_tok(l, ident_to_token_type(begin, end - begin), begin, end);
+    if (tok.type == TOK_IDENT && l->interner) tok.value.ident = intern(l->interner, begin, end - begin);
+    return tok;
+}
+
+Token take_ident(Lexer *l)
+{
+    const char *begin = l->cur;
+    const char *p = scan.skip_ident(begin + 1, l->end);
+    if (p < l->end && (*p & 0x80)) p = skip_ident_utf8(p, l->end);
+    return ident_tok(l, begin, p);
+}
+
+// A byte outside ASCII that is not in a string or comment: an identifier if
+// its character is XID_Start, otherwise an error.
+static Token take_utf8(Lexer *l, const char *at)
+{
+    uint32_t cp;
+    size_t n = utf8_decode(at, l->end, &cp);
+    if (!n) {
+        const char *p = at + 1;
+        while (p < l->end && (*p & 0x80) && !utf8_decode(p, l->end, &cp)) p++;
+        return error_tok(l, DIAG_INVALID_UTF8, at, p);
+    }
+    if (!is_xid_start(cp)) return error_tok(l, DIAG_UNEXPECTED_CHAR, at, at + n);
+    return ident_tok(l, at, skip_ident_utf8(at + n, l->end));
+}
+
+#define is_digit(c) (char_kind(c) == CC_DIGIT)
+
+// 0x and 0b literals.  The prefix only counts if a digit follows it.
+static int radix_bits(const char *p, const char *end)
+{
+    if (end - p < 3 || p[0] != '0') return 0;
+    switch (p[1]) {
+        case 'x': case 'X': return is_hex_char(p[2]) && p[2] != '_' ? 4 : 0;
+        case 'b': case 'B': return p[2] == '0' || p[2] == '1' ? 1 : 0;
+    }
+    return 0;
+}
+
+static Token take_radix(Lexer *l, int bits)
+{
+    const char *begin = l->cur;
+    const char *p = begin + 2;
+    if (bits == 4) {
+        while (p < l->end && is_hex_char(*p)) p++;
+    } else {
+        while (p < l->end && (*p == '0' || *p == '1' || *p == '_')) p++;
+    }
+    l->cur = p;
+
+    Token tok = make_tok(l, TOK_NUMBER, begin, p);
+    if (!parse_radix(begin + 2, p, bits, &tok.value.number_value)) {
+        return error_tok(l, DIAG_INT_RANGE, begin, p);
+    }
+    return tok;
+}
+
+Token take_num(Lexer *l)
+{
+    int bits = radix_bits(l->cur, l->end);
+    if (bits) return take_radix(l, bits);
+
+    Token tok;
+    const char *begin = l->cur;
+    const char *p = scan.skip_digits(begin + 1, l->end);
+
+    // A fraction needs a digit after the dot and an exponent a digit after
+    // the sign, so `1.x` and `1e` stay an integer followed by other tokens.
+    bool is_float = false;
+    if (l->end - p >= 2 && *p == '.' && is_digit(p[1])) {
+        p = scan.skip_digits(p + 2, l->end);
+        is_float = true;
+    }
+    if (p < l->end && (*p == 'e' || *p == 'E')) {
+        const char *e = p + 1;
+        if (e < l->end && (*e == '+' || *e == '-')) e++;
+        if (e < l->end && is_digit(*e)) {
+            p = scan.skip_digits(e + 1, l->end);
+            is_float = true;
+        }
+    }
+    l->cur = p;
+
+    if (is_float) {
+        tok = make_tok(l, TOK_FLOAT, begin, p);
+        tok.value.float_value = parse_float(begin, p);
+        return tok;
+    }
+
+    tok = make_tok(l, TOK_NUMBER, begin, p);
+    // Most literals are a few digits, which a plain loop converts faster
+    // than parse_decimal can set up.
+    if (p - begin < 8) {
+        int64_t v = 0;
+        for (const char *q = begin; q < p; q++) {
+            if (*q != '_') v = v * 10 + (*q - '0');
+        }
+        tok.value.number_value = v;
+        return tok;
+    }
+    if (!parse_decimal(begin, p, &tok.value.number_value)) {
+        return error_tok(l, DIAG_INT_RANGE, begin, p);
+    }
+    return tok;
+}
+
+// An unterminated string is reported up to the end of its line, where
+// lexing picks up again.
+static Token unterminated(Lexer *l, const char *begin)
+{
+    return error_tok(l, DIAG_UNTERMINATED_STRING, begin - 1, scan.find_newline(begin, l->end));
+}
+
+// Escape-free literals are found with one kernel call and stay a plain span;
+// escapes are only decoded if the string is materialized.
+Token take_string(Lexer *l, char quote)
+{
+    const char *begin = l->cur;
+    bool has_escapes = false;
+    bool valid = true;
+    const char *p = begin;
+    const char **unclosed = &l->unclosed[quote == '"'];
+    if (*unclosed && begin > *unclosed) return unterminated(l, begin);
+    for (;;) {
+        p = scan.find_string_end(p, l->end, quote);
+        if (p >= l->end) break;
+        if (*p == quote) {
+            if (!valid) return error_tok(l, DIAG_INVALID_UTF8, begin - 1, p + 1);
+            l->cur = p + 1;
+            STAT(l, string_bytes, p + 2 - begin);
+            Token tok = make_tok(l, TOK_STRING, begin, p);
+            tok.value.has_escapes = has_escapes;
+            return tok;
+        }
+
+        if (*p & 0x80) {
+            const char *q = skip_utf8(l, p);
+            valid &= q > p;
+            p = q > p ? q : p + 1;
+            continue;
+        }
+
+        has_escapes = true;
+        if (p + 1 >= l->end) break;
+        // An escaped character outside ASCII is left for the check above.
+        p += p[1] & 0x80 ? 1 : 2;
+    }
+
+    // A later string with the same quote would have to end at a quote this
+    // scan went past as escaped, so it cannot end either.  Remembering that
+    // keeps a file of stray quotes from being scanned to the end each time.
+    *unclosed = begin;
+    return unterminated(l, begin);
+}
+
+static size_t decode_string(const char *s, size_t len, char *out)
+{
+    size_t n = 0;
+    for (size_t i = 0; i < len; i++) {
+        char c = s[i];
+        if (c == '\\') {
+            switch (c = s[++i]) {
+                case 'n': c = '\n'; break;
+                case 't': c = '\t'; break;
+            }
+        }
+        out[n++] = c;
+    }
+    return n;
+}
+
+// Materializes the lexeme of `tok` as a NUL-terminated string in the lexer's
+// arena, decoding escapes for string literals that have any.  Interned
+// identifiers are returned without copying.
+const char *token_string(Lexer *l, Token tok)
+{
+    if (tok.type == TOK_IDENT && l->interner) return interner_str(l->interner, tok.value.ident);
+
+    const char *s = l->start + tok.offset;
+    char *out = arena_alloc(l->arena, tok.len + 1);
+    STAT(l, materialized, 1);
+    size_t len = tok.len;
+
+    if (tok.type == TOK_STRING && tok.value.has_escapes) len = decode_string(s, tok.len, out);
+    else memcpy(out, s, len);
+    out[len] = '\0';
+
+    return out;
+}
+
+// Runs the punctuator DFA from `at`, which starts a punctuator or comment,
+// and returns what the longest match is (TOK_ERROR if there is none, or
+// DFA_COMMENT) and sets *end past it.
+static inline TokenType match_punct(const Lexer *l, const char *at, const char **end)
+{
+    unsigned s = dfa_start[(unsigned char)*at];
+    const char *p = at + 1;
+    TokenType type = dfa_accept[s];
+    *end = p;
+    while (s < DFA_INNER && p < l->end) {
+        s = dfa_next[s][dfa_class[(unsigned char)*p++]];
+        if (!s) break;
+        if (dfa_accept[s] != TOK_ERROR) {
+            type = dfa_accept[s];
+            *end = p;
+        }
+    }
+    return type;
+}
+
+static Token unexpected(Lexer *l, const char *at)
+{
+    // Skip to the next byte that can start a token.
+    const char *p = at + 1;
+    while (p < l->end && char_kind(*p) == CC_NONE) p++;
+    return error_tok(l, DIAG_UNEXPECTED_CHAR, at, p);
+}
+
+Token next_token_switch(Lexer *l)
+{
+    for (;;) {
+        if (l->cur >= l->end) return make_tok(l, TOK_EOF, l->end, l->end);
+
+        const char *at = l->cur;
+        char c = *at;
+        switch (char_kind(c)) {
+            case CC_SPACE:
+                // Most runs are a single space, which is not worth a call.
+                l->cur++;
+                if (l->cur < l->end && char_kind(*l->cur) == CC_SPACE) {
+                    l->cur = scan.skip_space(l->cur + 1, l->end);
+                }
+                STAT(l, space_bytes, l->cur - at);
+                continue;
+            case CC_IDENT_START:
+                return take_ident(l);
+            case CC_DIGIT:
+                return take_num(l);
+            case CC_QUOTE:
+                l->cur++;
+                return take_string(l, c);
+            case CC_UTF8:
+                return take_utf8(l, at);
+            case CC_OP: {
+                const char *end;
+                TokenType type = match_punct(l, at, &end);
+                if (type == DFA_COMMENT) {
+                    if (!skip_comment(l, end)) return error_tok(l, DIAG_INVALID_UTF8, at, l->cur);
+                    STAT(l, comment_bytes, l->cur - at);
+                    continue;
+                }
+                if (type == TOK_ERROR) break;
+                l->cur = end;
+                return make_tok(l, type, at, end);
+            }
+        }
+
+        return unexpected(l, at);
+    }
+}
+
+#ifdef LEX_COMPUTED_GOTO
+// Jumps from each byte straight to the code for the token it starts, and from
+// whitespace and comments straight to the next byte's, instead of going
+// through the character class first.  The table must agree with char_class.
+Token next_token(Lexer *l)
+{
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverride-init"
+    static const void *const dispatch[256] = {
+        [0 ... 255] = &&none,
+        [' '] = &&space, ['\t'] = &&space, ['\n'] = &&space,
+        ['\v'] = &&space, ['\f'] = &&space, ['\r'] = &&space,
+        ['a' ... 'z'] = &&ident, ['A' ... 'Z'] = &&ident, ['_'] = &&ident,
+        ['0' ... '9'] = &&number,
+        ['"'] = &&string, ['\''] = &&string,
+        [0x80 ... 0xff] = &&utf8,
+#define PUNCT_LABEL(c) [c] = &&punct,
+        DFA_START_BYTES(PUNCT_LABEL)
+#undef PUNCT_LABEL
+    };
+#pragma GCC diagnostic pop
+    const char *at;
+
+#define DISPATCH() do {                                                     \
+        if (l->cur >= l->end) return make_tok(l, TOK_EOF, l->end, l->end); \
+        at = l->cur;                                                        \
+        goto *dispatch[(unsigned char)*at];                                 \
+    } while (0)
+
+    DISPATCH();
+space:
+    l->cur = at + 1;
+    if (l->cur < l->end && char_kind(*l->cur) == CC_SPACE) {
+        l->cur = scan.skip_space(l->cur + 1, l->end);
+    }
+    STAT(l, space_bytes, l->cur - at);
+    DISPATCH();
+punct: {
+        const char *end;
+        TokenType type = match_punct(l, at, &end);
+        if (type == DFA_COMMENT) {
+            if (!skip_comment(l, end)) return error_tok(l, DIAG_INVALID_UTF8, at, l->cur);
+            STAT(l, comment_bytes, l->cur - at);
+            DISPATCH();
+        }
+        if (type == TOK_ERROR) goto none;
+        l->cur = end;
+        return make_tok(l, type, at, end);
+    }
+ident:
+    return take_ident(l);
+number:
+    return take_num(l);
+string:
+    l->cur = at + 1;
+    return take_string(l, *at);
+utf8:
+    return take_utf8(l, at);
+none:
+    return unexpected(l, at);
+
+#undef DISPATCH
+}
+#else
+Token next_token(Lexer *l)
+{
+    return next_token_switch(l);
+}
+#endif
+
+void token_stream_reserve(TokenStream *ts, size_t tokens, size_t values)
+{
+    if (tokens > ts->cap) {
+        ts->cap = tokens;
+        ts->types = realloc(ts->types, ts->cap * sizeof(*ts->types));
+        ts->offsets = realloc(ts->offsets, ts->cap * sizeof(*ts->offsets));
+        ts->lens = realloc(ts->lens, ts->cap * sizeof(*ts->lens));
+        if (!ts->types || !ts->offsets || !ts->lens) PANIC("Out of memory");
+    }
+    if (values > ts->value_cap) {
+        ts->value_cap = values;
+        ts->values = realloc(ts->values, ts->value_cap * sizeof(*ts->values));
+        if (!ts->values) PANIC("Out of memory");
+    }
+}
+
+void token_stream_push(TokenStream *ts, Token tok)
+{
+    if (ts->count == ts->cap) token_stream_reserve(ts, ts->cap * 2 + 64, ts->value_cap);
+    if (token_has_value(tok.type)) {
+        if (ts->value_count == ts->value_cap) token_stream_reserve(ts, ts->cap, ts->value_cap * 2 + 64);
+        ts->values[ts->value_count++] = tok.value;
+    }
+
+    ts->types[ts->count] = tok.type;
+    ts->offsets[ts->count] = tok.offset;
+    ts->lens[ts->count] = tok.len;
+    ts->count++;
+}
+
+// Appends every token of the remaining input to `ts`, ending with TOK_EOF.
+void lex_all(Lexer *l, TokenStream *ts)
+{
+    static_assert(_TOK_COUNT <= UINT8_MAX, "TokenType does not fit in a byte");
+    if (l->end - l->start > UINT32_MAX) {
+        token_stream_push(ts, error_tok(l, DIAG_TOO_LARGE, l->start, l->start));
+        l->cur = l->end;
+        token_stream_push(ts, make_tok(l, TOK_EOF, l->start, l->start));
+        return;
+    }
+
+    // Typical sources have a token every 4-8 bytes; start near that to
+    // avoid most regrowth.
+    size_t guess = (l->end - l->cur) / 6 + 16;
+    token_stream_reserve(ts, ts->count + guess, ts->value_count + guess / 2);
+
+    Token tok;
+    do {
+        tok = next_token(l);
+        if (ts->count == ts->cap || ts->value_count == ts->value_cap) {
+            token_stream_push(ts, tok);
+            continue;
+        }
+
+        ts->types[ts->count] = tok.type;
+        ts->offsets[ts->count] = tok.offset;
+        ts->lens[ts->count] = tok.len;
+        ts->count++;
+        if (token_has_value(tok.type)) ts->values[ts->value_count++] = tok.value;
+    } while (tok.type != TOK_EOF);
+}
+
+// Rebuilds the i-th token.  `value` is the index of its value if it has one;
+// it is advanced past it, so a front-to-back walk starts it at 0.
+Token token_stream_get(const TokenStream *ts, size_t i, size_t *value)
+{
+    Token tok = {
+        .type = ts->types[i],
+        .len = ts->lens[i],
+        .offset = ts->offsets[i],
+    };
+    if (token_has_value(tok.type)) tok.value = ts->values[(*value)++];
+    return tok;
+}
+
+void token_stream_free(TokenStream *ts)
+{
+    free(ts->types);
+    free(ts->offsets);
+    free(ts->lens);
+    free(ts->values);
+    *ts = (TokenStream){ 0 };
+}
+
+// Appends the errors of `ts` to `d`.
+void diagnostics_collect(Diagnostics *d, const TokenStream *ts)
+{
+    size_t value = 0;
+    for (size_t i = 0; i < ts->count; i++) {
+        if (!token_has_value(ts->types[i])) continue;
+        if (ts->types[i] == TOK_ERROR) {
+            if (d->count == d->cap) {
+                d->cap = d->cap * 2 + 16;
+                d->items = realloc(d->items, d->cap * sizeof(*d->items));
+                if (!d->items) PANIC("Out of memory");
+            }
+            d->items[d->count++] = (Diagnostic) {
+                .code = ts->values[value].error,
+                .offset = ts->offsets[i],
+                .len = ts->lens[i],
+            };
+        }
+        value++;
+    }
+}
+
+const char *diagnostic_message(DiagnosticCode code)
+{
+    switch (code) {
+        case DIAG_UNEXPECTED_CHAR: return "Unexpected character";
+        case DIAG_UNTERMINATED_STRING: return "Unterminated string";
+        case DIAG_INT_RANGE: return "Integer literal out of range";
+        case DIAG_TOO_LARGE: return "Input too large for a token stream";
+        case DIAG_INVALID_UTF8: return "Invalid UTF-8";
+    }
+    return "Unknown error";
+}
+
+void diagnostics_free(Diagnostics *d)
+{
+    free(d->items);
+    *d = (Diagnostics){ 0 };
+}
+
+void print_tok(Lexer *l, Token tok)
+{
+    printf("%s ", names[tok.type]);
+
+    switch (tok.type) {
+        case TOK_NUMBER:
+            printf("%" PRId64, tok.value.number_value);
+            break;
+        case TOK_FLOAT:
+            printf("%.17g", tok.value.float_value);
+            break;
+        case TOK_IDENT:
+        case TOK_ERROR:
+            printf("%.*s", (int)tok.len, l->start + tok.offset);
+            break;
+        case TOK_STRING:
+            if (tok.value.has_escapes) {
+                printf("\"%s\"", token_string(l, tok));
+            } else {
+                printf("\"%.*s\"", (int)tok.len, l->start + tok.offset);
+            }
+            break;
+        default:
+            break;
+    }
+    printf("\n");
+}
@@ -0,0 +1,152 @@
+#ifndef LEXER_H
+#define LEXER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "arena.h"
+#include "intern.h"
+#include "keywords.h"
+#include "tokens.h"
+
+// next_token dispatches through a table of label addresses where the compiler
+// has them, and through next_token_switch elsewhere.
+#if defined(__GNUC__) && !defined(LEX_NO_COMPUTED_GOTO)
+#define LEX_COMPUTED_GOTO
+#endif
+
+typedef enum {
+    TOK_EOF = 0,
+    TOK_ERROR,
+#define PUNCT_TOKEN(name, text) TOK_##name,
+    PUNCTUATORS(PUNCT_TOKEN)
+#undef PUNCT_TOKEN
+    TOK_NUMBER,
+    TOK_FLOAT,
+    TOK_IDENT,
+    TOK_STRING,
+#define KEYWORD_TOKEN(name, text) TOK_##name,
+    KEYWORDS(KEYWORD_TOKEN)
+#undef KEYWORD_TOKEN
+    _TOK_COUNT,
+} TokenType;
+
+extern char *names[];
+
+typedef enum {
+    DIAG_UNEXPECTED_CHAR,
+    DIAG_UNTERMINATED_STRING,
+    DIAG_INT_RANGE,
+    DIAG_TOO_LARGE,
+    DIAG_INVALID_UTF8,
+} DiagnosticCode;
+
+typedef union {
+    int64_t number_value;
+    double float_value;
+    uint32_t ident;
+    bool has_escapes;
+    DiagnosticCode error;
+} TokenValue;
+
+// Tokens do not own any memory: `offset` and `len` locate the lexeme in the
+// source buffer.  For strings the span is the literal's contents without the
+// quotes; use token_string to get the decoded value.
+typedef struct {
+    TokenType type;
+    uint32_t len;
+    size_t offset;
+    TokenValue value;
+} Token;
+
+#ifdef LEX_STATS
+// Bytes of whitespace, comments, string literals (with their quotes) and
+// identifiers and keywords, and strings allocated by token_string.
+typedef struct {
+    size_t space_bytes;
+    size_t comment_bytes;
+    size_t string_bytes;
+    size_t word_bytes;
+    size_t materialized;
+} LexStats;
+#endif
+
+// A cursor over a contiguous source buffer of UTF-8.  The buffer is not
+// modified and need not be NUL-terminated.  Strings materialized from tokens live in
+// `arena`.  With an `interner`, identifier tokens carry their interned id.
+//
+// All state lives here, so separate lexers can run on separate threads.
+// Errors do not stop the lexer: each one becomes a TOK_ERROR token, whose
+// value is its DiagnosticCode, and is counted in `error_count`.
+//
+// Builds with LEX_STATS also count where the input's bytes go and how many
+// strings token_string allocates; without it the counters do not exist.
+typedef struct {
+    const char *start;
+    const char *cur;
+    const char *end;
+    Arena *arena;
+    Interner *interner;
+    size_t error_count;
+    // Strings opened after these with ' and " respectively cannot be closed.
+    const char *unclosed[2];
+    // The input in [utf8_begin, utf8_end) is known to be UTF-8.
+    const char *utf8_begin, *utf8_end;
+#ifdef LEX_STATS
+    LexStats stats;
+#endif
+} Lexer;
+
+// The tokens of a whole buffer as columns: one byte of type and a 32-bit
+// offset and length per token.  Only numbers, floats, identifiers, strings
+// and errors (their DiagnosticCode) have a value, as token_has_value says;
+// theirs are stored in order in `values`, so the n-th such token's value is
+// values[n].
+typedef struct {
+    uint8_t *types;
+    uint32_t *offsets;
+    uint32_t *lens;
+    TokenValue *values;
+    size_t count;
+    size_t value_count;
+    size_t cap;
+    size_t value_cap;
+} TokenStream;
+
+typedef struct {
+    DiagnosticCode code;
+    size_t offset;
+    uint32_t len;
+} Diagnostic;
+
+// The errors of a stream, in order.
+typedef struct {
+    Diagnostic *items;
+    size_t count;
+    size_t cap;
+} Diagnostics;
+
+void lexer_init(Lexer *l, const char *data, size_t len, Arena *arena, Interner *interner);
+Token next_token(Lexer *l);
+// The portable dispatch next_token falls back to without computed goto.
+Token next_token_switch(Lexer *l);
+const char *token_string(Lexer *l, Token tok);
+void print_tok(Lexer *l, Token tok);
+
+static inline bool token_has_value(TokenType type)
+{
+    return type == TOK_NUMBER || type == TOK_FLOAT || type == TOK_IDENT || type == TOK_STRING || type == TOK_ERROR;
+}
+
+void lex_all(Lexer *l, TokenStream *ts);
+void token_stream_reserve(TokenStream *ts, size_t tokens, size_t values);
+void token_stream_push(TokenStream *ts, Token tok);
+Token token_stream_get(const TokenStream *ts, size_t i, size_t *value);
+void token_stream_free(TokenStream *ts);
+
+void diagnostics_collect(Diagnostics *d, const TokenStream *ts);
+const char *diagnostic_message(DiagnosticCode code);
+void diagnostics_free(Diagnostics *d);
+
+#endif // LEXER_H
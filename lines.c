@@ -0,0 +1,52 @@
+#include <stdlib.h>
+
+#include "common.h"
+#include "lines.h"
+#include "scan.h"
+
+#define LINES_BLOCK (64 * 1024)
+
+bool line_index_build(LineIndex *li, const char *data, size_t len)
+{
+    *li = (LineIndex){ 0 };
+    if (len > UINT32_MAX) return false;
+
+    // Sources average 20-40 bytes a line; blocks of input are indexed into
+    // whatever room that leaves, growing it when a block might not fit.
+    size_t cap = len / 32 + LINES_BLOCK + 1;
+    li->starts = malloc(cap * sizeof(*li->starts));
+    if (!li->starts) PANIC("Out of memory");
+    li->starts[li->count++] = 0;
+
+    for (size_t at = 0; at < len; at += LINES_BLOCK) {
+        size_t n = len - at < LINES_BLOCK ? len - at : LINES_BLOCK;
+        if (li->count + n > cap) {
+            cap = cap * 2 + n;
+            li->starts = realloc(li->starts, cap * sizeof(*li->starts));
+            if (!li->starts) PANIC("Out of memory");
+        }
+        li->count += scan.index_lines(data + at, data + at + n, at, li->starts + li->count);
+    }
+    return true;
+}
+
+void line_index_find(const LineIndex *li, size_t offset, uint32_t *line, uint32_t *col)
+{
+    size_t lo = 0, hi = li->count;
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (li->starts[mid] <= offset) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    *line = lo + 1;
+    *col = offset - li->starts[lo] + 1;
+}
+
+void line_index_free(LineIndex *li)
+{
+    free(li->starts);
+    *li = (LineIndex){ 0 };
+}
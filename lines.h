@@ -0,0 +1,21 @@
+#ifndef LINES_H
+#define LINES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// The offset at which each line of a buffer starts, so that token offsets
+// can be turned into line and column only where they are shown.
+typedef struct {
+    uint32_t *starts;
+    size_t count;
+} LineIndex;
+
+// Returns false if the buffer is too large for 32-bit offsets.
+bool line_index_build(LineIndex *li, const char *data, size_t len);
+// Line and column (both from 1) of a byte offset.
+void line_index_find(const LineIndex *li, size_t offset, uint32_t *line, uint32_t *col);
+void line_index_free(LineIndex *li);
+
+#endif // LINES_H
@@ -1,259 +1,161 @@
-#include <assert.h>
-#include <ctype.h>
 #include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
-#include <stdbool.h>
+#include <time.h>
 
-#define _PRINT_MSG(prefix, ...) do {              \
-    printf(prefix" %s:%d ", __FILE__, __LINE__);  \
-    printf(__VA_ARGS__);                          \
-    printf("\n");                                 \
-} while(0);                                       \
+#include "common.h"
+#include "lexer.h"
+#include "lines.h"
+#include "source.h"
+#include "tokbin.h"
 
-#define DBG(...) _PRINT_MSG("[DBG]", __VA_ARGS__)
-#define PANIC(...) do {                           \
-    _PRINT_MSG("[PANIC]", __VA_ARGS__);           \
-    exit(1);                                      \
-} while (0);
-
-typedef enum {
-    TOK_EOF = 0,
-    TOK_PLUS,
-    TOK_MINUS,
-    TOK_LPAREN,
-    TOK_RPAREN,
-    TOK_LBRACE,
-    TOK_RBRACE,
-    TOK_LBRACKET,
-    TOK_RBRACKET,
-    TOK_SEMICOLON,
-    TOK_EQUALS,
-    TOK_NUMBER,
-    TOK_IDENT,
-    TOK_STRING,
-    TOK_LET,
-    _TOK_COUNT,
-} TokenType;
-
-char *names[] = {
-    [TOK_EOF] = "EOF",
-    [TOK_PLUS] = "+",
-    [TOK_MINUS] = "-",
-    [TOK_LPAREN] = "(",
-    [TOK_RPAREN] = ")",
-    [TOK_LBRACE] = "{",
-    [TOK_RBRACE] = "}",
-    [TOK_LBRACKET] = "[",
-    [TOK_RBRACKET] = "]",
-    [TOK_SEMICOLON] = ";",
-    [TOK_EQUALS] = "=",
-    [TOK_NUMBER] = "NUMBER",
-    [TOK_IDENT] = "IDENT",
-    [TOK_LET] = "LET",
-    [TOK_STRING] = "STRING",
-};
+static void usage(const char *prog)
+{
+    fprintf(stderr, "Usage: %s [--emit=tokens|tokens-bin] [--stats] <file>\n", prog);
+    exit(2);
+}
 
-static_assert(sizeof(names)/sizeof(*names) == _TOK_COUNT, "Not every token is named");
+enum { PHASE_READ, PHASE_LEX, PHASE_OUTPUT, PHASE_DIAGNOSTICS, PHASE_COUNT };
 
-typedef union {
-    int number_value;
-    char *string_value;
-} TokenValue;
+static const char *phase_names[] = { "read", "lex", "output", "diagnostics" };
 
 typedef struct {
-    TokenType type;
-    TokenValue value;
-} Token;
-
-TokenType ident_to_token_type(char *ident) {
-    if (!strcmp(ident, "let")) return TOK_LET;
-    return TOK_IDENT;
-}
+    double wall[PHASE_COUNT];
+    double cpu[PHASE_COUNT];
+    struct timespec wall_start, cpu_start;
+} Phases;
 
-void remove_chars(char *s, char c) {
-    int i = 0;
-    for (char *v = s; *v; v++) {
-        if (*v != c) {
-            s[i++] = *v;
-        }
-    }
-    s[i] = '\0';
+static double elapsed(struct timespec from, struct timespec to)
+{
+    return (to.tv_sec - from.tv_sec) + (to.tv_nsec - from.tv_nsec) / 1e9;
 }
 
-char take_char(FILE *f) {
-    char ret = fgetc(f);
-    if (ferror(f)) PANIC("Cannot read file: %m");
-
-    return ret;
+static void phase_start(Phases *p)
+{
+    clock_gettime(CLOCK_MONOTONIC, &p->wall_start);
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &p->cpu_start);
 }
 
-char peek_char(FILE *f) {
-    char ret = take_char(f);
-    ungetc(ret, f);
-    return ret;
+static void phase_end(Phases *p, int phase)
+{
+    struct timespec wall, cpu;
+    clock_gettime(CLOCK_MONOTONIC, &wall);
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu);
+    p->wall[phase] += elapsed(p->wall_start, wall);
+    p->cpu[phase] += elapsed(p->cpu_start, cpu);
 }
 
-char *take_ident(FILE *f)
+static void print_share(const char *name, size_t n, size_t total)
 {
-    char buf[256] = { 0 };
-    size_t str_len = 0;
-
-    char c;
-    while(isalnum(c = peek_char(f)) || c == '_') {
-        take_char(f);
-        buf[str_len++] = c;
-    }
-
-    char *out = malloc(str_len + 1);
-    memcpy(out, buf, str_len);
-    out[str_len] = '\0';
-
-    return out;
+    fprintf(stderr, "  %-12s %12zu %6.2f%%\n", name, n, total ? 100.0 * n / total : 0);
 }
 
-int take_num(FILE *f)
+static void print_stats(const Phases *p, const Lexer *l, const TokenStream *ts, const Arena *arena,
+                        const Interner *interner)
 {
-    int out = 0;
-    char c;
-    while(isdigit(c = peek_char(f)) || c == '_') {
-        take_char(f);
-        if (c == '_') continue;
-        out *= 10;
-        out += c - '0';
+    fprintf(stderr, "%-14s %10s %10s\n", "phase", "wall ms", "cpu ms");
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        fprintf(stderr, "%-14s %10.3f %10.3f\n", phase_names[i], p->wall[i] * 1e3, p->cpu[i] * 1e3);
     }
 
-    return out;
-}
-
-char *take_string(FILE *f, bool single_quote) {
-    size_t cap = 1024;
-    size_t len = 0;
-    char *buf = malloc(cap);
-
-    bool escaping = false;
-    char c;
-    char target_quote = single_quote ? '\'' : '"';
-    while ((c = take_char(f)) != target_quote || escaping) {
-        if (escaping) {
-            switch (c) {
-                case 'n': c = '\n'; break;
-                case 't': c = '\t'; break;
-            }
-        }
-
-        if (escaping || c != '\\') {
-            if (len >= cap - 1) buf = realloc(buf, cap *= 2);
-            buf[len++] = c;
-            escaping = false;
-        } else {
-            escaping = true;
-            continue;
-        }
+    size_t counts[_TOK_COUNT] = { 0 };
+    for (size_t i = 0; i < ts->count; i++) counts[ts->types[i]]++;
+    fprintf(stderr, "tokens %zu\n", ts->count);
+    for (int type = 0; type < _TOK_COUNT; type++) {
+        if (counts[type]) print_share(names[type], counts[type], ts->count);
     }
 
-    buf[len] = '\0';
-    return buf;
+    size_t bytes = l->end - l->start;
+#ifdef LEX_STATS
+    const LexStats *s = &l->stats;
+    fprintf(stderr, "bytes %zu\n", bytes);
+    print_share("whitespace", s->space_bytes, bytes);
+    print_share("comments", s->comment_bytes, bytes);
+    print_share("strings", s->string_bytes, bytes);
+    print_share("words", s->word_bytes, bytes);
+    print_share("other", bytes - s->space_bytes - s->comment_bytes - s->string_bytes - s->word_bytes, bytes);
+    fprintf(stderr, "strings materialized %zu\n", s->materialized);
+#else
+    fprintf(stderr, "bytes %zu (build with STATS=1 for a breakdown)\n", bytes);
+#endif
+    arena_print_stats(arena, stderr);
+    interner_print_stats(interner, stderr);
 }
 
-Token next_token(FILE *f)
+int main(int argc, char **argv)
 {
-    char c;
-    for (;;) {
-        switch (c = take_char(f)) {
-            case '+': return (Token){ TOK_PLUS, 0 };
-            case '-': return (Token){ TOK_MINUS, 0 };
-            case '(': return (Token){ TOK_LPAREN, 0 };
-            case ')': return (Token){ TOK_RPAREN, 0 };
-            case '{': return (Token){ TOK_LBRACE, 0 };
-            case '}': return (Token){ TOK_RBRACE, 0 };
-            case '[': return (Token){ TOK_LBRACKET, 0 };
-            case ']': return (Token){ TOK_RBRACKET, 0 };
-            case ';': return (Token){ TOK_SEMICOLON, 0 };
-            case '=': return (Token){ TOK_EQUALS, 0 };
-            case '/': {
-                if (peek_char(f) == '/') {
-                    take_char(f);
-                    char p;
-                    while ((p = peek_char(f)) != '\n' && p != '\0') {
-                        take_char(f);
-                    }
-                    continue;
-                }
-            } break;
-            case '\'':
-            case '"': {
-                char *str = take_string(f, c == '\'');
-                return (Token) {
-                    .type = TOK_STRING,
-                    .value = (TokenValue) {
-                        .string_value = str
-                    },
-                };
-            } break;
+    bool binary = false, stats = false;
+    const char *path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--emit=tokens")) {
+            binary = false;
+        } else if (!strcmp(argv[i], "--emit=tokens-bin")) {
+            binary = true;
+        } else if (!strcmp(argv[i], "--stats")) {
+            stats = true;
+        } else if (!path && (argv[i][0] != '-' || !argv[i][1])) {
+            path = argv[i];
+        } else {
+            usage(argv[0]);
         }
-        
-        if (isspace(c)) continue;
-        else if (isalpha(c) || c == '_') {
-            ungetc(c, f);
-            char *ident = take_ident(f);
-            TokenType type = ident_to_token_type(ident);
-            return (Token) {
-                .type = type,
-                .value = (TokenValue) {
-                    .string_value = type == TOK_IDENT ? ident : 0
-                },
-            };
-        } else if (isdigit(c)) {
-            ungetc(c, f);
-            int num = take_num(f);
-            return (Token) {
-                .type = TOK_NUMBER,
-                .value = (TokenValue) {
-                    .number_value = num
-                },
-            };
+    }
+    if (!path) usage(argv[0]);
+
+    Phases phases = { 0 };
+    phase_start(&phases);
+    Source src;
+    if (!source_open(&src, path)) PANIC("Cannot open %s: %m", path);
+    phase_end(&phases, PHASE_READ);
+
+    phase_start(&phases);
+    Arena arena;
+    arena_init(&arena, 0);
+
+    Interner interner;
+    interner_init(&interner, &arena);
+
+    Lexer l;
+    lexer_init(&l, src.data, src.len, &arena, &interner);
+
+    TokenStream ts = { 0 };
+    lex_all(&l, &ts);
+    phase_end(&phases, PHASE_LEX);
+
+    phase_start(&phases);
+    if (binary) {
+        if (!tokbin_write(1, &ts)) PANIC("Cannot write tokens: %m");
+    } else {
+        size_t value = 0;
+        for (size_t i = 0; i < ts.count; i++) {
+            print_tok(&l, token_stream_get(&ts, i, &value));
         }
-
-        if (c == EOF) return (Token){ 0 };
-
-        PANIC("Unexpected token '%c'", c);
     }
-}
 
-void print_tok(Token tok)
-{
-    printf("%s ", names[tok.type]);
-
-    switch (tok.type) {
-        case TOK_NUMBER:
-            printf("%d", tok.value.number_value);
-            break;
-        case TOK_IDENT:
-            printf("%s", tok.value.string_value);
-            break;
-        case TOK_STRING:
-            printf("\"%s\"", tok.value.string_value);
-            break;
-        case TOK_PLUS:
-        case TOK_MINUS:
-        case TOK_EOF:
-            break;
+    fflush(stdout);
+    phase_end(&phases, PHASE_OUTPUT);
+
+    phase_start(&phases);
+    Diagnostics diags = { 0 };
+    diagnostics_collect(&diags, &ts);
+    if (diags.count) {
+        LineIndex li;
+        if (!line_index_build(&li, src.data, src.len)) PANIC("Input too large");
+        for (size_t i = 0; i < diags.count; i++) {
+            Diagnostic d = diags.items[i];
+            uint32_t line, col;
+            line_index_find(&li, d.offset, &line, &col);
+            fprintf(stderr, "%s:%u:%u: %s", path, line, col, diagnostic_message(d.code));
+            if (d.code == DIAG_UNEXPECTED_CHAR) fprintf(stderr, " '%.*s'", (int)d.len, src.data + d.offset);
+            fprintf(stderr, "\n");
+        }
+        line_index_free(&li);
     }
-    printf("\n");
-}
-
-int main(int argc, char **argv)
-{
-    assert(argc == 2);
-
-    Token tok;
-    FILE *f = fopen(argv[1], "r");
-
-    do {
-        tok = next_token(f);
-        print_tok(tok);
-    } while (tok.type != TOK_EOF);
-
-    return 0;
+    phase_end(&phases, PHASE_DIAGNOSTICS);
+    if (stats) print_stats(&phases, &l, &ts, &arena, &interner);
+
+    int status = diags.count ? 1 : 0;
+    diagnostics_free(&diags);
+    token_stream_free(&ts);
+    arena_free(&arena);
+    source_free(&src);
+    return status;
 }
@@ -0,0 +1,272 @@
+#include "number.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Enough for any int64_t; longer literals overflow without being parsed.
+#define MAX_DIGITS 19
+
+#define is_digit(c) ((unsigned)((unsigned char)(c) - '0') < 10)
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+
+static uint64_t load_eight(const char *p)
+{
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// True if all eight bytes are '0'..'9': each high nibble must be 3, and
+// adding 6 must not carry into it.
+static bool is_eight_digits(uint64_t v)
+{
+    return ((v & 0xF0F0F0F0F0F0F0F0) | (((v + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4))
+        == 0x3333333333333333;
+}
+
+// Converts eight ASCII digits at once: pairs, then quads, then the whole
+// word, each step a multiply-add over the lanes of one 64-bit register.
+static uint32_t parse_eight(uint64_t v)
+{
+    v -= 0x3030303030303030;
+    v = v * 10 + (v >> 8);
+    v = ((v & 0x000000FF000000FF) * (100 + (1000000ULL << 32))
+         + ((v >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32))) >> 32;
+    return v;
+}
+
+// The first `k` (< 8) bytes at p as a word of digits, padded on the left
+// with '0's.  Reads all eight bytes, so p must have eight readable bytes.
+static uint64_t load_leading(const char *p, size_t k)
+{
+    if (k == 0) return 0x3030303030303030;
+    return (load_eight(p) << (8 * (8 - k))) | (0x3030303030303030 >> (8 * k));
+}
+
+#define HAVE_SWAR 1
+#endif
+
+// Converts at most MAX_DIGITS bytes; fails on anything but digits.  Eight
+// or more digits are split into whole words read from the end of the
+// literal, plus a zero-padded word for the leading remainder, so there is
+// no per-digit loop or length-dependent trip count.
+static bool convert(const char *p, const char *end, uint64_t *out)
+{
+    size_t len = end - p;
+#ifdef HAVE_SWAR
+    if (len >= 8) {
+        bool three = len >= 16;
+        uint64_t lo = load_eight(end - 8);
+        uint64_t mid = three ? load_eight(end - 16) : load_leading(p, len - 8);
+        uint64_t hi = three ? load_leading(p, len - 16) : 0x3030303030303030;
+        if (!is_eight_digits(lo) || !is_eight_digits(mid) || !is_eight_digits(hi)) return false;
+
+        *out = (uint64_t)parse_eight(hi) * 10000000000000000
+            + (uint64_t)parse_eight(mid) * 100000000
+            + parse_eight(lo);
+        return true;
+    }
+#endif
+
+    uint64_t v = 0;
+    for (; p < end; p++) {
+        unsigned d = (unsigned char)*p - '0';
+        if (d > 9) return false;
+        v = v * 10 + d;
+    }
+    *out = v;
+    return true;
+}
+
+bool parse_decimal(const char *p, const char *end, int64_t *out)
+{
+    uint64_t v;
+    if (end - p > MAX_DIGITS || !convert(p, end, &v)) {
+        // Separators or leading zeros: squeeze out everything that does not
+        // contribute a significant digit and convert that.
+        char buf[MAX_DIGITS];
+        size_t n = 0;
+        for (; p < end; p++) {
+            if (*p == '_' || (*p == '0' && n == 0)) continue;
+            if (n == MAX_DIGITS) return false;
+            buf[n++] = *p;
+        }
+        convert(buf, buf + n, &v);
+    }
+
+    if (v > INT64_MAX) return false;
+    *out = v;
+    return true;
+}
+
+bool parse_radix(const char *p, const char *end, int bits, int64_t *out)
+{
+    uint64_t v = 0;
+    for (; p < end; p++) {
+        if (*p == '_') continue;
+
+        unsigned d = *p <= '9' ? *p - '0' : (*p | 0x20) - 'a' + 10;
+        if (v >> (63 - bits)) return false;
+        v = v << bits | d;
+    }
+
+    *out = v;
+    return true;
+}
+
+// Clinger's fast path: when both the mantissa and 10^|q| are exact doubles,
+// one IEEE multiply or divide is correctly rounded.
+static const double exact_pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+#include "pow5.gen.h"
+
+#define MANTISSA_BITS 52
+#define MIN_EXPONENT (-1023)
+
+// Eisel-Lemire: multiply the normalized mantissa by a 128-bit approximation
+// of 5^q and take the top bits.  Returns false in the rare cases where the
+// truncated product cannot decide the rounding.
+static bool eisel_lemire(uint64_t w, int64_t q, double *out)
+{
+    if (q < POW5_SMALLEST) {
+        *out = 0.0;
+        return true;
+    }
+    if (q > POW5_LARGEST) {
+        *out = __builtin_inf();
+        return true;
+    }
+
+    int lz = __builtin_clzll(w);
+    w <<= lz;
+
+    size_t index = 2 * (q - POW5_SMALLEST);
+    unsigned __int128 first = (unsigned __int128)w * pow5_128[index];
+    uint64_t hi = first >> 64, lo = (uint64_t)first;
+
+    // Unless the bits below the 55 we keep are all ones, the error of the
+    // first product cannot reach them.
+    const uint64_t precision_mask = UINT64_MAX >> (MANTISSA_BITS + 3);
+    if ((hi & precision_mask) == precision_mask) {
+        uint64_t second_hi = ((unsigned __int128)w * pow5_128[index + 1]) >> 64;
+        lo += second_hi;
+        if (second_hi > lo) hi++;
+        if (lo == UINT64_MAX && (q < -27 || q > 55)) return false;
+    }
+
+    int upperbit = hi >> 63;
+    int shift = upperbit + 64 - MANTISSA_BITS - 3;
+    uint64_t mantissa = hi >> shift;
+    int32_t power2 = (int32_t)((((152170 + 65536) * q) >> 16) + 63) + upperbit - lz - MIN_EXPONENT;
+
+    if (power2 <= 0) {
+        // Subnormal: shift into place and round; rounding may carry into the
+        // smallest normal exponent.
+        if (-power2 + 1 >= 64) {
+            *out = 0.0;
+            return true;
+        }
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        power2 = mantissa < (1ULL << MANTISSA_BITS) ? 0 : 1;
+    } else {
+        // Exactly halfway between two doubles can only happen for these
+        // exponents; round it to even rather than up.
+        if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << shift) == hi) {
+            mantissa &= ~1ULL;
+        }
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        if (mantissa >= (2ULL << MANTISSA_BITS)) {
+            mantissa = 1ULL << MANTISSA_BITS;
+            power2++;
+        }
+        mantissa &= ~(1ULL << MANTISSA_BITS);
+        if (power2 >= 0x7FF) {
+            power2 = 0x7FF;
+            mantissa = 0;
+        }
+    }
+
+    uint64_t bits = mantissa | (uint64_t)power2 << MANTISSA_BITS;
+    memcpy(out, &bits, sizeof(*out));
+    return true;
+}
+
+static double parse_float_slow(const char *p, const char *end)
+{
+    char buf[512];
+    char *copy = end - p < (ptrdiff_t)sizeof(buf) ? buf : malloc(end - p + 1);
+    size_t n = 0;
+    for (; p < end; p++) {
+        if (*p != '_') copy[n++] = *p;
+    }
+    copy[n] = '\0';
+
+    double out = strtod(copy, NULL);
+    if (copy != buf) free(copy);
+    return out;
+}
+
+double parse_float(const char *p, const char *end)
+{
+    const char *start = p;
+    uint64_t w = 0;
+    int digits = 0;
+    int64_t q = 0;
+    bool truncated = false;
+
+    // Up to 19 significant digits fit in w; further integer digits only
+    // scale it, further fraction digits are dropped.
+    for (; p < end && (is_digit(*p) || *p == '_'); p++) {
+        if (*p == '_') continue;
+        if (digits < MAX_DIGITS) {
+            w = w * 10 + (*p - '0');
+            digits += w != 0;
+        } else {
+            q++;
+            truncated |= *p != '0';
+        }
+    }
+    if (p < end && *p == '.') {
+        for (p++; p < end && (is_digit(*p) || *p == '_'); p++) {
+            if (*p == '_') continue;
+            if (digits < MAX_DIGITS) {
+                w = w * 10 + (*p - '0');
+                digits += w != 0;
+                q--;
+            } else {
+                truncated |= *p != '0';
+            }
+        }
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool negative = p < end && *p == '-';
+        if (p < end && (*p == '-' || *p == '+')) p++;
+
+        int64_t e = 0;
+        for (; p < end; p++) {
+            if (*p != '_' && e < 100000) e = e * 10 + (*p - '0');
+        }
+        q += negative ? -e : e;
+    }
+
+    if (w == 0) return 0.0;
+    if (truncated) return parse_float_slow(start, end);
+
+    if (q >= -22 && q <= 22 && w <= (1ULL << 53)) {
+        double d = (double)w;
+        return q < 0 ? d / exact_pow10[-q] : d * exact_pow10[q];
+    }
+
+    double out;
+    if (eisel_lemire(w, q, &out)) return out;
+    return parse_float_slow(start, end);
+}
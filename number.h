@@ -0,0 +1,21 @@
+#ifndef NUMBER_H
+#define NUMBER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// All parsers skip '_' separators.
+
+// Parses the decimal digits in [p, end).  Returns false if the value does
+// not fit in an int64_t.
+bool parse_decimal(const char *p, const char *end, int64_t *out);
+
+// Parses the hex (bits = 4) or binary (bits = 1) digits in [p, end), without
+// the 0x/0b prefix.  Returns false if the value does not fit in an int64_t.
+bool parse_radix(const char *p, const char *end, int bits, int64_t *out);
+
+// Parses `digits [. digits] [(e|E) [+|-] digits]` in [p, end), correctly
+// rounded to the nearest double.
+double parse_float(const char *p, const char *end);
+
+#endif // NUMBER_H
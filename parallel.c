@@ -0,0 +1,167 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "intern.h"
+#include "parallel.h"
+#include "scan.h"
+
+// The input is cut into chunks just after a newline, and each chunk is lexed
+// on its own thread as if a token started there.  That guess is wrong when
+// the cut falls inside a multi-line string, so a chunk's tokens are only a
+// guess: it keeps whatever tokens start before the next cut, errors
+// included.
+//
+// The chunks are then stitched together in order.  A serial lexer continues
+// from the end of the stream so far until it produces the same token as
+// the chunk at the same offset.  Lexing only depends on the position, so
+// from there on the chunk's tokens are exactly what the serial lexer would
+// produce, and they are copied over.  Only the tokens before that point are
+// lexed twice, which for an ordinary cut is just the first one.
+
+typedef struct {
+    Lexer lexer;
+    // Tokens starting at or after `limit` belong to the next chunk.
+    size_t limit;
+    // The position after the last kept token.
+    size_t end;
+    TokenStream ts;
+    pthread_t thread;
+    bool threaded;
+} Chunk;
+
+static void *lex_chunk(void *arg)
+{
+    Chunk *c = arg;
+    Lexer *l = &c->lexer;
+
+    size_t guess = (c->limit - (l->cur - l->start)) / 6 + 16;
+    token_stream_reserve(&c->ts, guess, guess / 2);
+
+    c->end = l->cur - l->start;
+    for (;;) {
+        Token tok = next_token(l);
+        if (tok.offset >= c->limit) break;
+
+        token_stream_push(&c->ts, tok);
+        c->end = l->cur - l->start;
+        if (tok.type == TOK_EOF) break;
+    }
+    return NULL;
+}
+
+static void append(TokenStream *ts, const TokenStream *from, size_t first, size_t first_value)
+{
+    size_t n = from->count - first;
+    size_t values = from->value_count - first_value;
+    token_stream_reserve(ts, ts->count + n, ts->value_count + values);
+
+    if (n) {
+        memcpy(ts->types + ts->count, from->types + first, n * sizeof(*ts->types));
+        memcpy(ts->offsets + ts->count, from->offsets + first, n * sizeof(*ts->offsets));
+        memcpy(ts->lens + ts->count, from->lens + first, n * sizeof(*ts->lens));
+        ts->count += n;
+    }
+    if (values) {
+        memcpy(ts->values + ts->value_count, from->values + first_value, values * sizeof(*ts->values));
+        ts->value_count += values;
+    }
+}
+
+// Lexes serially from `l` until it meets the chunk's tokens, then takes the
+// rest of them.  Returns true once TOK_EOF has been added.
+static bool merge(Lexer *l, TokenStream *ts, const Chunk *c)
+{
+    const TokenStream *from = &c->ts;
+    size_t k = 0, value = 0;
+
+    while (k < from->count) {
+        Token tok = next_token(l);
+        token_stream_push(ts, tok);
+        if (tok.type == TOK_EOF) return true;
+
+        for (; k < from->count && from->offsets[k] < tok.offset; k++) {
+            if (token_has_value(from->types[k])) value++;
+        }
+        // A string's span starts after its quote, so the offset alone
+        // could also be that of a token lexed from inside the string.
+        if (k < from->count && from->offsets[k] == tok.offset && from->types[k] == tok.type) {
+            if (token_has_value(from->types[k])) value++;
+            append(ts, from, k + 1, value);
+            l->cur = l->start + c->end;
+            return ts->types[ts->count - 1] == TOK_EOF;
+        }
+    }
+    return false;
+}
+
+void lex_all_parallel(Lexer *l, TokenStream *ts, int threads)
+{
+    size_t len = l->end - l->cur;
+    if (threads < 1) threads = 1;
+    if ((size_t)threads > len / PARALLEL_MIN_CHUNK) threads = len / PARALLEL_MIN_CHUNK;
+    if (threads <= 1 || l->end - l->start > UINT32_MAX) {
+        lex_all(l, ts);
+        return;
+    }
+
+    Chunk *chunks = calloc(threads, sizeof(*chunks));
+    if (!chunks) PANIC("Out of memory");
+
+    int n = 0;
+    const char *cut = l->cur;
+    for (int i = 0; i < threads && cut < l->end; i++) {
+        const char *next = l->cur + len / threads * (i + 1);
+        if (i == threads - 1 || next >= l->end) {
+            next = l->end;
+        } else {
+            next = scan.find_newline(next, l->end);
+            if (next < l->end) next++;
+        }
+
+        Chunk *c = &chunks[n++];
+        c->lexer = *l;
+        c->lexer.cur = cut;
+        c->lexer.interner = NULL;
+        c->limit = next == l->end ? (size_t)(l->end - l->start) + 1 : (size_t)(next - l->start);
+        cut = next;
+    }
+
+    // A chunk that did not get a thread is lexed here instead.
+    for (int i = 1; i < n; i++) {
+        chunks[i].threaded = !pthread_create(&chunks[i].thread, NULL, lex_chunk, &chunks[i]);
+    }
+    lex_chunk(&chunks[0]);
+    for (int i = 1; i < n; i++) {
+        if (chunks[i].threaded) {
+            pthread_join(chunks[i].thread, NULL);
+        } else {
+            lex_chunk(&chunks[i]);
+        }
+    }
+
+    // Identifiers are interned afterwards and in order, so that their ids
+    // come out the same as with lex_all; errors are counted then too.
+    size_t first = ts->count, first_value = ts->value_count;
+    Lexer serial = *l;
+    serial.interner = NULL;
+
+    bool done = false;
+    for (int i = 0; i < n && !done; i++) done = merge(&serial, ts, &chunks[i]);
+    if (!done) lex_all(&serial, ts);
+    l->cur = serial.cur;
+
+    size_t value = first_value;
+    for (size_t i = first; i < ts->count; i++) {
+        if (!token_has_value(ts->types[i])) continue;
+        if (ts->types[i] == TOK_IDENT && l->interner) {
+            ts->values[value].ident = intern(l->interner, l->start + ts->offsets[i], ts->lens[i]);
+        }
+        l->error_count += ts->types[i] == TOK_ERROR;
+        value++;
+    }
+
+    for (int i = 0; i < n; i++) token_stream_free(&chunks[i].ts);
+    free(chunks);
+}
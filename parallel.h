@@ -0,0 +1,14 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "lexer.h"
+
+// Below this many bytes per thread, splitting costs more than it saves.
+#define PARALLEL_MIN_CHUNK (256 * 1024)
+
+// Same as lex_all, but lexes the input on up to `threads` threads; fewer
+// than 1 means 1.  The resulting stream (including interned ids) is
+// identical to lex_all's.
+void lex_all_parallel(Lexer *l, TokenStream *ts, int threads);
+
+#endif // PARALLEL_H
@@ -0,0 +1,123 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "push.h"
+#include "scan.h"
+
+// Only a string can run past the end of a line.  So when a piece is cut just
+// after its last newline, lexing up to the cut gives exactly the tokens the
+// whole input would, except that a string still open at the cut comes out
+// as an unterminated-string error.  That string and the unfinished last line
+// are carried over to the next piece.  Nothing else is kept, so the carry
+// never grows beyond a line or a multi-line string.
+//
+// Neither is looked at again until it can end: only new bytes are searched
+// for a newline, and an open string is searched for its closing quote from
+// where the last search stopped.  Pieces are appended after the carry, which
+// is only moved to the front of `buf` once the input consumed in front of
+// it is as long as it is, so each byte is copied a bounded number of times.
+
+void push_lexer_init(PushLexer *p, Arena *arena, Interner *interner)
+{
+    *p = (PushLexer){ 0 };
+    lexer_init(&p->lexer, NULL, 0, arena, interner);
+}
+
+static char *reserve(char *buf, size_t *cap, size_t len)
+{
+    if (len <= *cap) return buf;
+    while (*cap < len) *cap = *cap * 2 + 4096;
+    buf = realloc(buf, *cap);
+    if (!buf) PANIC("Out of memory");
+    return buf;
+}
+
+// Whether the string opened at `s[0]` closes in [s + from, s + to), where
+// `from` is not inside an escape.  Follows take_string.
+static bool string_closes(const char *s, size_t from, size_t to)
+{
+    const char *p = s + from, *end = s + to;
+    for (;;) {
+        p = scan.find_string_end(p, end, *s);
+        if (p >= end) return false;
+        if (*p == *s) return true;
+        p += *p == '\\' ? 2 : 1;
+    }
+}
+
+bool push_lexer_feed(PushLexer *p, const char *data, size_t len, bool last, TokenStream *ts)
+{
+    Lexer *l = &p->lexer;
+
+    const char *window = data;
+    size_t window_len = len;
+    if (p->carry_len) {
+        if (p->carry_at >= p->carry_len) {
+            memmove(p->buf, p->buf + p->carry_at, p->carry_len);
+            p->carry_at = 0;
+        }
+        window_len = p->carry_len + len;
+        p->buf = reserve(p->buf, &p->buf_cap, p->carry_at + window_len);
+        memcpy(p->buf + p->carry_at + p->carry_len, data, len);
+        window = p->buf + p->carry_at;
+    }
+    p->window = window;
+    p->base = p->consumed;
+
+    // The carry holds no newline after its first carry_lines bytes.
+    size_t cut = window_len;
+    if (!last) {
+        while (cut > p->carry_len && window[cut - 1] != '\n') cut--;
+        if (cut == p->carry_len) cut = p->carry_lines;
+    }
+    if (p->base + cut > UINT32_MAX) return false;
+
+    size_t done = 0;
+    if (p->carry_lines && !last && !string_closes(window, p->carry_lines, cut)) {
+        p->carry_lines = cut;
+    } else {
+        l->start = window;
+        l->cur = window;
+        l->end = window + cut;
+        l->unclosed[0] = l->unclosed[1] = NULL;
+        l->utf8_begin = l->utf8_end = window;
+        done = cut;
+        p->carry_lines = 0;
+        for (;;) {
+            Token tok = next_token(l);
+            if (tok.type == TOK_EOF && !last) break;
+            if (tok.type == TOK_ERROR && tok.value.error == DIAG_UNTERMINATED_STRING && !last) {
+                // The string was scanned to the cut, which follows a
+                // newline and so cannot be inside an escape.
+                l->error_count--;
+                done = tok.offset;
+                p->carry_lines = cut - done;
+                break;
+            }
+
+            tok.offset += p->base;
+            token_stream_push(ts, tok);
+            if (tok.type == TOK_EOF) break;
+        }
+    }
+
+    size_t rest = window_len - done;
+    if (window == data) {
+        p->buf = reserve(p->buf, &p->buf_cap, rest);
+        if (rest) memcpy(p->buf, data + done, rest);
+        p->carry_at = 0;
+    } else {
+        p->carry_at += done;
+    }
+    p->carry_len = rest;
+    p->consumed += done;
+    return true;
+}
+
+void push_lexer_free(PushLexer *p)
+{
+    free(p->buf);
+    *p = (PushLexer){ 0 };
+}
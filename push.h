@@ -0,0 +1,37 @@
+#ifndef PUSH_H
+#define PUSH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "lexer.h"
+
+// Lexes input that arrives in pieces.  Each feed appends the tokens that are
+// complete so far; the unfinished rest is kept for the next one.  Offsets
+// count from the start of the whole input.
+typedef struct {
+    Lexer lexer;
+    // The text of the tokens added by the last feed is at
+    // window + (offset - base) until the next feed.
+    const char *window;
+    size_t base;
+    // Input from offset `consumed` on is not lexed yet; it waits at
+    // buf + carry_at for the next piece to be appended.
+    size_t consumed;
+    char *buf;
+    size_t buf_cap;
+    size_t carry_at;
+    size_t carry_len;
+    // If not 0, the carry starts with a string that is still open after its
+    // first `carry_lines` bytes, which are whole lines.
+    size_t carry_lines;
+} PushLexer;
+
+void push_lexer_init(PushLexer *p, Arena *arena, Interner *interner);
+// Lexes the next `len` bytes of input into `ts`.  With `last` the input ends
+// here and the stream gets its TOK_EOF.  Returns false if the input has
+// grown too large for a token stream.
+bool push_lexer_feed(PushLexer *p, const char *data, size_t len, bool last, TokenStream *ts);
+void push_lexer_free(PushLexer *p);
+
+#endif // PUSH_H
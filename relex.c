@@ -0,0 +1,276 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "relex.h"
+#include "dfa.gen.h"
+#include "utf8.h"
+
+// Lexing from a token start depends only on the text from there on.  So the
+// tokens before the edit are kept up to the last one that could have looked
+// at an edited byte, and lexing restarts after it.  Once it produces a token
+// of the same type at the same (shifted) place as an old token lying wholly
+// behind the edit, the rest of the old stream is valid again.  The gap is
+// moved to where lexing restarts, so the old tokens after it are already at
+// their shifted places.
+
+// How far past a token's end lexing it may look: the rest of the longest
+// punctuator, or a whole character outside ASCII, which identifiers and
+// invalid UTF-8 decode to see where they end.  Numbers (`1.5`, `1e+5`,
+// `0x1`) look at most 3 bytes ahead.
+#define LOOKAHEAD (DFA_MAX_LEN > UTF8_MAX_LEN ? DFA_MAX_LEN : UTF8_MAX_LEN)
+
+static size_t token_count(const RelexStream *rs)
+{
+    return rs->gap + rs->cap - rs->gap_end;
+}
+
+// Where token `i` is stored.
+static size_t slot(const RelexStream *rs, size_t i)
+{
+    return i < rs->gap ? i : i + rs->gap_end - rs->gap;
+}
+
+static size_t slot_offset(const RelexStream *rs, size_t s)
+{
+    return s < rs->gap ? rs->offsets[s] : rs->text_len - rs->offsets[s];
+}
+
+static size_t slot_start(const RelexStream *rs, size_t s)
+{
+    return slot_offset(rs, s) - (rs->types[s] == TOK_STRING);
+}
+
+static size_t slot_end(const RelexStream *rs, size_t s)
+{
+    return slot_offset(rs, s) + rs->lens[s] + (rs->types[s] == TOK_STRING);
+}
+
+static bool is_open(TokenType type, TokenValue value)
+{
+    return type == TOK_ERROR && value.error == DIAG_UNTERMINATED_STRING;
+}
+
+void relex_stream_init(RelexStream *rs, Lexer *l)
+{
+    TokenStream ts = { 0 };
+    lex_all(l, &ts);
+    *rs = (RelexStream){
+        .types = ts.types,
+        .offsets = ts.offsets,
+        .lens = ts.lens,
+        .gap = ts.count,
+        .gap_end = ts.cap,
+        .cap = ts.cap,
+        .values = ts.values,
+        .value_gap = ts.value_count,
+        .value_gap_end = ts.value_cap,
+        .value_cap = ts.value_cap,
+        .text_len = l->end - l->start,
+        .open = ts.count,
+    };
+
+    size_t value = 0;
+    for (size_t i = 0; i < ts.count; i++) {
+        Token tok = token_stream_get(&ts, i, &value);
+        if (is_open(tok.type, tok.value)) {
+            rs->open = i;
+            break;
+        }
+    }
+}
+
+void relex_stream_tokens(const RelexStream *rs, TokenStream *ts)
+{
+    size_t tail = rs->cap - rs->gap_end;
+    size_t value_tail = rs->value_cap - rs->value_gap_end;
+    token_stream_reserve(ts, ts->count + rs->gap + tail, ts->value_count + rs->value_gap + value_tail);
+
+    if (rs->gap) {
+        memcpy(ts->types + ts->count, rs->types, rs->gap * sizeof(*ts->types));
+        memcpy(ts->offsets + ts->count, rs->offsets, rs->gap * sizeof(*ts->offsets));
+        memcpy(ts->lens + ts->count, rs->lens, rs->gap * sizeof(*ts->lens));
+        ts->count += rs->gap;
+    }
+    if (tail) {
+        memcpy(ts->types + ts->count, rs->types + rs->gap_end, tail * sizeof(*ts->types));
+        memcpy(ts->lens + ts->count, rs->lens + rs->gap_end, tail * sizeof(*ts->lens));
+        for (size_t s = rs->gap_end; s < rs->cap; s++) ts->offsets[ts->count++] = rs->text_len - rs->offsets[s];
+    }
+
+    if (rs->value_gap) {
+        memcpy(ts->values + ts->value_count, rs->values, rs->value_gap * sizeof(*ts->values));
+        ts->value_count += rs->value_gap;
+    }
+    if (value_tail) {
+        memcpy(ts->values + ts->value_count, rs->values + rs->value_gap_end, value_tail * sizeof(*ts->values));
+        ts->value_count += value_tail;
+    }
+}
+
+void relex_stream_free(RelexStream *rs)
+{
+    free(rs->types);
+    free(rs->offsets);
+    free(rs->lens);
+    free(rs->values);
+    *rs = (RelexStream){ 0 };
+}
+
+// Makes room for at least `tokens` tokens and `values` values in the gaps.
+static void reserve_gap(RelexStream *rs, size_t tokens, size_t values)
+{
+    if (rs->gap_end - rs->gap < tokens) {
+        size_t tail = rs->cap - rs->gap_end;
+        size_t cap = rs->cap * 2 + tokens;
+        rs->types = realloc(rs->types, cap * sizeof(*rs->types));
+        rs->offsets = realloc(rs->offsets, cap * sizeof(*rs->offsets));
+        rs->lens = realloc(rs->lens, cap * sizeof(*rs->lens));
+        if (!rs->types || !rs->offsets || !rs->lens) PANIC("Out of memory");
+        memmove(rs->types + cap - tail, rs->types + rs->gap_end, tail * sizeof(*rs->types));
+        memmove(rs->offsets + cap - tail, rs->offsets + rs->gap_end, tail * sizeof(*rs->offsets));
+        memmove(rs->lens + cap - tail, rs->lens + rs->gap_end, tail * sizeof(*rs->lens));
+        rs->gap_end = cap - tail;
+        rs->cap = cap;
+    }
+    if (rs->value_gap_end - rs->value_gap < values) {
+        size_t tail = rs->value_cap - rs->value_gap_end;
+        size_t cap = rs->value_cap * 2 + values;
+        rs->values = realloc(rs->values, cap * sizeof(*rs->values));
+        if (!rs->values) PANIC("Out of memory");
+        memmove(rs->values + cap - tail, rs->values + rs->value_gap_end, tail * sizeof(*rs->values));
+        rs->value_gap_end = cap - tail;
+        rs->value_cap = cap;
+    }
+}
+
+// Moves the gap to just before token `i`.  The tokens it passes switch
+// between offsets and distances from the end, which are the same thing
+// reflected, so the conversion is its own inverse.
+static void move_gap(RelexStream *rs, size_t i)
+{
+    size_t from, to, n, values = 0;
+    if (i < rs->gap) {
+        n = rs->gap - i;
+        from = i;
+        to = rs->gap_end - n;
+        for (size_t s = from; s < from + n; s++) values += token_has_value(rs->types[s]);
+        for (size_t k = n; k-- > 0;) rs->offsets[to + k] = rs->text_len - rs->offsets[from + k];
+        memmove(rs->values + rs->value_gap_end - values, rs->values + rs->value_gap - values,
+                values * sizeof(*rs->values));
+        rs->gap -= n;
+        rs->gap_end -= n;
+        rs->value_gap -= values;
+        rs->value_gap_end -= values;
+    } else {
+        n = i - rs->gap;
+        from = rs->gap_end;
+        to = rs->gap;
+        for (size_t s = from; s < from + n; s++) values += token_has_value(rs->types[s]);
+        for (size_t k = 0; k < n; k++) rs->offsets[to + k] = rs->text_len - rs->offsets[from + k];
+        memmove(rs->values + rs->value_gap, rs->values + rs->value_gap_end, values * sizeof(*rs->values));
+        rs->gap += n;
+        rs->gap_end += n;
+        rs->value_gap += values;
+        rs->value_gap_end += values;
+    }
+    memmove(rs->types + to, rs->types + from, n * sizeof(*rs->types));
+    memmove(rs->lens + to, rs->lens + from, n * sizeof(*rs->lens));
+}
+
+void relex(Lexer *l, RelexStream *rs, size_t offset, size_t removed, size_t inserted)
+{
+    assert((size_t)(l->end - l->start) == rs->text_len - removed + inserted);
+    if (rs->text_len > UINT32_MAX || l->end - l->start > UINT32_MAX) {
+        relex_stream_free(rs);
+        relex_stream_init(rs, l);
+        return;
+    }
+
+    // The first token whose lexing could have read an edited byte.  An
+    // unterminated string was scanned to the end of the text, so an edit
+    // anywhere after it may close it.
+    size_t count = token_count(rs);
+    size_t lo = 0, hi = count - 1;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (slot_end(rs, slot(rs, mid)) + LOOKAHEAD > offset) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    size_t first = rs->open < lo ? rs->open : lo;
+    move_gap(rs, first);
+    l->cur = l->start + (first ? slot_end(rs, first - 1) : 0);
+    rs->text_len = l->end - l->start;
+
+    // Old tokens from `old` on are kept; those between the gap and it were
+    // lexed over.
+    TokenStream fresh = { 0 };
+    size_t old = rs->gap_end, old_value = rs->value_gap_end;
+    for (;;) {
+        Token tok = next_token(l);
+
+        // Tokens starting in or before the inserted text have no old
+        // counterpart.
+        size_t start = tok.offset - (tok.type == TOK_STRING);
+        if (start >= offset + inserted) {
+            while (old < rs->cap && slot_start(rs, old) < start) old_value += token_has_value(rs->types[old++]);
+            if (old < rs->cap && slot_start(rs, old) == start && rs->types[old] == tok.type) break;
+        }
+
+        token_stream_push(&fresh, tok);
+        if (tok.type == TOK_EOF) {
+            old = rs->cap;
+            old_value = rs->value_cap;
+            break;
+        }
+    }
+
+    size_t dropped = old - rs->gap_end;
+    rs->gap_end = old;
+    rs->value_gap_end = old_value;
+    reserve_gap(rs, fresh.count, fresh.value_count);
+    if (fresh.count) {
+        memcpy(rs->types + rs->gap, fresh.types, fresh.count * sizeof(*rs->types));
+        memcpy(rs->offsets + rs->gap, fresh.offsets, fresh.count * sizeof(*rs->offsets));
+        memcpy(rs->lens + rs->gap, fresh.lens, fresh.count * sizeof(*rs->lens));
+        rs->gap += fresh.count;
+    }
+    if (fresh.value_count) {
+        memcpy(rs->values + rs->value_gap, fresh.values, fresh.value_count * sizeof(*rs->values));
+        rs->value_gap += fresh.value_count;
+    }
+
+    // The first unterminated string is at or after `first`.  Only if the
+    // edit removed it do the tokens after the edit have to be searched.
+    size_t open = rs->open;
+    rs->open = token_count(rs);
+    size_t value = 0;
+    for (size_t i = 0; i < fresh.count; i++) {
+        Token tok = token_stream_get(&fresh, i, &value);
+        if (is_open(tok.type, tok.value)) {
+            rs->open = first + i;
+            break;
+        }
+    }
+    if (rs->open == token_count(rs)) {
+        if (open >= first + dropped) {
+            rs->open = open - dropped + fresh.count;
+        } else {
+            value = rs->value_gap_end;
+            for (size_t s = rs->gap_end; s < rs->cap; s++) {
+                if (!token_has_value(rs->types[s])) continue;
+                if (is_open(rs->types[s], rs->values[value++])) {
+                    rs->open = s - rs->gap_end + rs->gap;
+                    break;
+                }
+            }
+        }
+    }
+
+    token_stream_free(&fresh);
+}
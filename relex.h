@@ -0,0 +1,40 @@
+#ifndef RELEX_H
+#define RELEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lexer.h"
+
+// The tokens of a text that is being edited.  They are kept in a gap buffer
+// that stays where the last edit was: tokens before the gap store their
+// offset, and those after it their distance from the end of the text, which
+// an edit before them does not change.  So an edit only touches the tokens
+// it lexes again and the ones between it and the previous edit.
+typedef struct {
+    uint8_t *types;
+    uint32_t *offsets;
+    uint32_t *lens;
+    size_t gap, gap_end, cap;
+    TokenValue *values;
+    size_t value_gap, value_gap_end, value_cap;
+    size_t text_len;
+    // The index of the first unterminated string, or the token count if
+    // there is none.
+    size_t open;
+} RelexStream;
+
+// Lexes all of the text of `l` into `rs`.
+void relex_stream_init(RelexStream *rs, Lexer *l);
+// Appends the tokens of `rs` to `ts`.
+void relex_stream_tokens(const RelexStream *rs, TokenStream *ts);
+void relex_stream_free(RelexStream *rs);
+
+// Updates `rs` after `removed` bytes at `offset` were replaced by `inserted`
+// new ones.  `l` is a fresh lexer over the edited text.  Only the tokens
+// around the edit are lexed again; the result is the same as lexing the new
+// text from scratch.
+void relex(Lexer *l, RelexStream *rs, size_t offset, size_t removed, size_t inserted);
+
+#endif // RELEX_H
@@ -0,0 +1,485 @@
+#include "scan.h"
+
+#include <string.h>
+
+#include "charclass.h"
+#include "utf8.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SCAN_X86
+#include <immintrin.h>
+#endif
+
+static const char *skip_space_scalar(const char *p, const char *end)
+{
+    while (p < end && char_kind(*p) == CC_SPACE) p++;
+    return p;
+}
+
+static const char *find_newline_scalar(const char *p, const char *end)
+{
+    while (p < end && *p != '\n') p++;
+    return p;
+}
+
+static const char *find_comment_end_scalar(const char *p, const char *end)
+{
+    while (p < end && *p != '\n' && !(*p & 0x80)) p++;
+    return p;
+}
+
+static const char *find_string_end_scalar(const char *p, const char *end, char quote)
+{
+    while (p < end && *p != quote && *p != '\\' && !(*p & 0x80)) p++;
+    return p;
+}
+
+static const char *skip_ident_scalar(const char *p, const char *end)
+{
+    while (p < end && is_ident_char(*p)) p++;
+    return p;
+}
+
+static const char *skip_digits_scalar(const char *p, const char *end)
+{
+    while (p < end && is_num_char(*p)) p++;
+    return p;
+}
+
+static size_t index_lines_scalar(const char *p, const char *end, uint32_t base, uint32_t *out)
+{
+    size_t n = 0;
+    for (const char *s = p; s < end; s++) {
+        if (*s == '\n') out[n++] = base + (s - p) + 1;
+    }
+    return n;
+}
+
+static const char *find_invalid_utf8_scalar(const char *p, const char *end)
+{
+    uint32_t cp;
+    while (p < end) {
+        if (!(*p & 0x80)) {
+            p++;
+            continue;
+        }
+        size_t n = utf8_decode(p, end, &cp);
+        if (!n) return p;
+        p += n;
+    }
+    return p;
+}
+
+#ifdef SCAN_X86
+
+// Whitespace is ' ' or one of \t \n \v \f \r, which are 9..13.  SSE has no
+// unsigned compare, so the range check shifts 9 to -128 and compares signed.
+static inline __m128i space_mask_sse2(__m128i v)
+{
+    __m128i sp = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+    __m128i ctl = _mm_cmplt_epi8(_mm_add_epi8(v, _mm_set1_epi8(128 - 9)), _mm_set1_epi8(-128 + 5));
+    return _mm_or_si128(sp, ctl);
+}
+
+static const char *skip_space_sse2(const char *p, const char *end)
+{
+    for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)p);
+        unsigned mask = ~_mm_movemask_epi8(space_mask_sse2(v)) & 0xffff;
+        if (mask) return p + __builtin_ctz(mask);
+    }
+    return skip_space_scalar(p, end);
+}
+
+static const char *find_newline_sse2(const char *p, const char *end)
+{
+    __m128i nl = _mm_set1_epi8('\n');
+    for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)p);
+        unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(v, nl));
+        if (mask) return p + __builtin_ctz(mask);
+    }
+    return find_newline_scalar(p, end);
+}
+
+// The sign bit of each byte is already the one movemask takes, so bytes
+// outside ASCII are stopped at by OR-ing in the input.
+static const char *find_comment_end_sse2(const char *p, const char *end)
+{
+    __m128i nl = _mm_set1_epi8('\n');
+    for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)p);
+        unsigned mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, nl), v));
+        if (mask) return p + __builtin_ctz(mask);
+    }
+    return find_comment_end_scalar(p, end);
+}
+
+static const char *find_string_end_sse2(const char *p, const char *end, char quote)
+{
+    __m128i q = _mm_set1_epi8(quote);
+    __m128i bs = _mm_set1_epi8('\\');
+    for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)p);
+        __m128i stop = _mm_or_si128(_mm_cmpeq_epi8(v, q), _mm_cmpeq_epi8(v, bs));
+        unsigned mask = _mm_movemask_epi8(_mm_or_si128(stop, v));
+        if (mask) return p + __builtin_ctz(mask);
+    }
+    return find_string_end_scalar(p, end, quote);
+}
+
+// Unsigned `lo <= v < lo + n` with signed compares, as in space_mask_sse2.
+static inline __m128i range_mask_sse2(__m128i v, char lo, char n)
+{
+    return _mm_cmplt_epi8(_mm_add_epi8(v, _mm_set1_epi8(128 - lo)), _mm_set1_epi8(-128 + n));
+}
+
+static inline __m128i digits_mask_sse2(__m128i v)
+{
+    return _mm_or_si128(range_mask_sse2(v, '0', 10), _mm_cmpeq_epi8(v, _mm_set1_epi8('_')));
+}
+
+static inline __m128i ident_mask_sse2(__m128i v)
+{
+    __m128i letter = range_mask_sse2(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 26);
+    return _mm_or_si128(letter, digits_mask_sse2(v));
+}
+
+static const char *skip_ident_sse2(const char *p, const char *end)
+{
+    for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)p);
+        unsigned mask = ~_mm_movemask_epi8(ident_mask_sse2(v)) & 0xffff;
+        if (mask) return p + __builtin_ctz(mask);
+    }
+    return skip_ident_scalar(p, end);
+}
+
+static const char *skip_digits_sse2(const char *p, const char *end)
+{
+    for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)p);
+        unsigned mask = ~_mm_movemask_epi8(digits_mask_sse2(v)) & 0xffff;
+        if (mask) return p + __builtin_ctz(mask);
+    }
+    return skip_digits_scalar(p, end);
+}
+
+static size_t index_lines_sse2(const char *p, const char *end, uint32_t base, uint32_t *out)
+{
+    __m128i nl = _mm_set1_epi8('\n');
+    size_t n = 0;
+    const char *s = p;
+    for (; end - s >= 16; s += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)s);
+        unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(v, nl));
+        for (uint32_t at = base + (s - p) + 1; mask; mask &= mask - 1) {
+            out[n++] = at + __builtin_ctz(mask);
+        }
+    }
+    return n + index_lines_scalar(s, end, base + (s - p), out + n);
+}
+
+// SSE2 has no byte shuffle for the table lookups of the AVX2 version, so
+// this only skips ASCII 16 bytes at a time and decodes everything else.
+static const char *find_invalid_utf8_sse2(const char *p, const char *end)
+{
+    uint32_t cp;
+    while (end - p >= 16) {
+        unsigned mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)p));
+        if (!mask) {
+            p += 16;
+            continue;
+        }
+        p += __builtin_ctz(mask);
+        size_t n = utf8_decode(p, end, &cp);
+        if (!n) return p;
+        p += n;
+    }
+    return find_invalid_utf8_scalar(p, end);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i space_mask_avx2(__m256i v)
+{
+    __m256i sp = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' '));
+    __m256i ctl = _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 5), _mm256_add_epi8(v, _mm256_set1_epi8(128 - 9)));
+    return _mm256_or_si256(sp, ctl);
+}
+
+__attribute__((target("avx2")))
+static const char *skip_space_avx2(const char *p, const char *end)
+{
+    for (; end - p >= 32; p += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)p);
+        unsigned mask = ~(unsigned)_mm256_movemask_epi8(space_mask_avx2(v));
+        if (mask) return p + __builtin_ctz(mask);
+    }
+    return skip_space_sse2(p, end);
+}
+
+__attribute__((target("avx2")))
+static const char *find_newline_avx2(const char *p, const char *end)
+{
+    __m256i nl = _mm256_set1_epi8('\n');
+    for (; end - p >= 32; p += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)p);
+        unsigned mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, nl));
+        if (mask) return p + __builtin_ctz(mask);
+    }
+    return find_newline_sse2(p, end);
+}
+
+__attribute__((target("avx2")))
+static const char *find_comment_end_avx2(const char *p, const char *end)
+{
+    __m256i nl = _mm256_set1_epi8('\n');
+    for (; end - p >= 32; p += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)p);
+        unsigned mask = _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, nl), v));
+        if (mask) return p + __builtin_ctz(mask);
+    }
+    return find_comment_end_sse2(p, end);
+}
+
+__attribute__((target("avx2")))
+static const char *find_string_end_avx2(const char *p, const char *end, char quote)
+{
+    __m256i q = _mm256_set1_epi8(quote);
+    __m256i bs = _mm256_set1_epi8('\\');
+    for (; end - p >= 32; p += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)p);
+        __m256i stop = _mm256_or_si256(_mm256_cmpeq_epi8(v, q), _mm256_cmpeq_epi8(v, bs));
+        unsigned mask = _mm256_movemask_epi8(_mm256_or_si256(stop, v));
+        if (mask) return p + __builtin_ctz(mask);
+    }
+    return find_string_end_sse2(p, end, quote);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i range_mask_avx2(__m256i v, char lo, char n)
+{
+    return _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + n), _mm256_add_epi8(v, _mm256_set1_epi8(128 - lo)));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i digits_mask_avx2(__m256i v)
+{
+    return _mm256_or_si256(range_mask_avx2(v, '0', 10), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_')));
+}
+
+__attribute__((target("avx2")))
+static const char *skip_ident_avx2(const char *p, const char *end)
+{
+    for (; end - p >= 32; p += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)p);
+        __m256i letter = range_mask_avx2(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 26);
+        unsigned mask = ~(unsigned)_mm256_movemask_epi8(_mm256_or_si256(letter, digits_mask_avx2(v)));
+        if (mask) return p + __builtin_ctz(mask);
+    }
+    return skip_ident_sse2(p, end);
+}
+
+__attribute__((target("avx2")))
+static const char *skip_digits_avx2(const char *p, const char *end)
+{
+    for (; end - p >= 32; p += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)p);
+        unsigned mask = ~(unsigned)_mm256_movemask_epi8(digits_mask_avx2(v));
+        if (mask) return p + __builtin_ctz(mask);
+    }
+    return skip_digits_sse2(p, end);
+}
+
+__attribute__((target("avx2")))
+static size_t index_lines_avx2(const char *p, const char *end, uint32_t base, uint32_t *out)
+{
+    __m256i nl = _mm256_set1_epi8('\n');
+    size_t n = 0;
+    const char *s = p;
+    for (; end - s >= 32; s += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)s);
+        unsigned mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, nl));
+        for (uint32_t at = base + (s - p) + 1; mask; mask &= mask - 1) {
+            out[n++] = at + __builtin_ctz(mask);
+        }
+    }
+    return n + index_lines_sse2(s, end, base + (s - p), out + n);
+}
+
+// Keiser and Lemire's validation ("Validating UTF-8 in less than one
+// instruction per byte").  Each error in a pair of adjacent bytes sets a
+// bit in all three of the tables looked up by the first byte's high and
+// low nibbles and the second byte's high nibble; ANDing them leaves only
+// real errors.  A continuation byte is only expected there, and those the
+// tables cannot see (the third and fourth of a long sequence) are checked
+// against the bytes two and three before.
+#define UTF8_TOO_SHORT (1 << 0)
+#define UTF8_TOO_LONG (1 << 1)
+#define UTF8_OVERLONG_3 (1 << 2)
+#define UTF8_TOO_LARGE (1 << 3)
+#define UTF8_SURROGATE (1 << 4)
+#define UTF8_OVERLONG_2 (1 << 5)
+#define UTF8_TOO_LARGE_1000 (1 << 6)
+#define UTF8_OVERLONG_4 (1 << 6)
+#define UTF8_TWO_CONTS (1 << 7)
+#define UTF8_CARRY (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+
+#define TABLE_AVX2(...) _mm256_setr_epi8(__VA_ARGS__, __VA_ARGS__)
+
+// The bytes `n` before each byte of `v`, coming from the end of `prev`.
+#define PREV_AVX2(v, prev, n) _mm256_alignr_epi8(v, _mm256_permute2x128_si256(prev, v, 0x21), 16 - (n))
+
+__attribute__((target("avx2")))
+static inline __m256i high_nibbles_avx2(__m256i v)
+{
+    return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0f));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i utf8_errors_avx2(__m256i v, __m256i prev)
+{
+    const __m256i byte_1_high = TABLE_AVX2(
+        // 0_______: ASCII
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        // 10______: continuation
+        UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+        // 1100____, 1101____: two-byte lead
+        UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+        UTF8_TOO_SHORT,
+        // 1110____: three-byte lead
+        UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+        // 1111____: four-byte lead
+        UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4);
+    const __m256i byte_1_low = TABLE_AVX2(
+        UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,
+        UTF8_CARRY | UTF8_OVERLONG_2,
+        UTF8_CARRY,
+        UTF8_CARRY,
+        UTF8_CARRY | UTF8_TOO_LARGE,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000);
+    const __m256i byte_2_high = TABLE_AVX2(
+        // 0_______: ASCII
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        // 1000____, 1001____, 101_____: continuation
+        UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+        UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE,
+        UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+        UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+        // 11______: lead
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT);
+
+    __m256i prev1 = PREV_AVX2(v, prev, 1);
+    __m256i special = _mm256_and_si256(
+        _mm256_and_si256(_mm256_shuffle_epi8(byte_1_high, high_nibbles_avx2(prev1)),
+                         _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(prev1, _mm256_set1_epi8(0x0f)))),
+        _mm256_shuffle_epi8(byte_2_high, high_nibbles_avx2(v)));
+
+    // Only 111_____ two back and 1111____ three back leave the top bit set.
+    __m256i third = _mm256_subs_epu8(PREV_AVX2(v, prev, 2), _mm256_set1_epi8(0xe0 - 0x80));
+    __m256i fourth = _mm256_subs_epu8(PREV_AVX2(v, prev, 3), _mm256_set1_epi8(0xf0 - 0x80));
+    __m256i must_continue = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(0x80));
+    return _mm256_xor_si256(must_continue, special);
+}
+
+__attribute__((target("avx2")))
+static const char *find_invalid_utf8_avx2(const char *p, const char *end)
+{
+    // A lead byte this close to the end of a block needs the next block.
+    const __m256i incomplete_above = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0xf0 - 1, 0xe0 - 1, 0xc0 - 1);
+    const char *begin = p;
+    __m256i prev = _mm256_setzero_si256();
+    __m256i incomplete = _mm256_setzero_si256();
+    for (; end - p >= 32; p += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)p);
+        if (!_mm256_movemask_epi8(v)) {
+            if (!_mm256_testz_si256(incomplete, incomplete)) break;
+        } else {
+            __m256i errors = utf8_errors_avx2(v, prev);
+            if (!_mm256_testz_si256(errors, errors)) break;
+            incomplete = _mm256_subs_epu8(v, incomplete_above);
+        }
+        prev = v;
+    }
+
+    // Everything before `p` is valid but for a character it cuts, which
+    // starts at most three bytes back.  The rest, or the block with the
+    // error, is decoded from there.
+    const char *q = p - begin > 3 ? p - 3 : begin;
+    while (q < p && (*q & 0xc0) == 0x80) q++;
+    return find_invalid_utf8_sse2(q, end);
+}
+
+#endif // SCAN_X86
+
+static const ScanKernels kernels[] = {
+    {
+        "scalar", skip_space_scalar, find_newline_scalar, find_comment_end_scalar,
+        find_string_end_scalar, skip_ident_scalar, skip_digits_scalar, index_lines_scalar,
+        find_invalid_utf8_scalar,
+    },
+#ifdef SCAN_X86
+    {
+        "sse2", skip_space_sse2, find_newline_sse2, find_comment_end_sse2,
+        find_string_end_sse2, skip_ident_sse2, skip_digits_sse2, index_lines_sse2,
+        find_invalid_utf8_sse2,
+    },
+    {
+        "avx2", skip_space_avx2, find_newline_avx2, find_comment_end_avx2,
+        find_string_end_avx2, skip_ident_avx2, skip_digits_avx2, index_lines_avx2,
+        find_invalid_utf8_avx2,
+    },
+#endif
+};
+
+ScanKernels scan = {
+    "scalar", skip_space_scalar, find_newline_scalar, find_comment_end_scalar,
+    find_string_end_scalar, skip_ident_scalar, skip_digits_scalar, index_lines_scalar,
+    find_invalid_utf8_scalar,
+};
+
+static bool supported(const char *name)
+{
+#ifdef SCAN_X86
+    if (!strcmp(name, "sse2")) return __builtin_cpu_supports("sse2");
+    if (!strcmp(name, "avx2")) return __builtin_cpu_supports("avx2");
+#endif
+    return !strcmp(name, "scalar");
+}
+
+bool scan_use(const char *name)
+{
+    if (!supported(name)) return false;
+    for (size_t i = 0; i < sizeof(kernels)/sizeof(*kernels); i++) {
+        if (!strcmp(kernels[i].name, name)) {
+            scan = kernels[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+__attribute__((constructor))
+static void scan_init(void)
+{
+#ifdef SCAN_X86
+    __builtin_cpu_init();
+#endif
+    for (size_t i = sizeof(kernels)/sizeof(*kernels); i-- > 0;) {
+        if (scan_use(kernels[i].name)) break;
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef SCAN_H
+#define SCAN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Bulk scanning kernels used by the lexer's hot loops.  Each returns the
+// first position in [p, end) that ends the run, or `end`.  The best
+// implementation for the running CPU is picked at startup.
+typedef struct {
+    const char *name;
+    const char *(*skip_space)(const char *p, const char *end);
+    const char *(*find_newline)(const char *p, const char *end);
+    // Stops at a newline or a byte outside ASCII.
+    const char *(*find_comment_end)(const char *p, const char *end);
+    // Stops at `quote`, a backslash or a byte outside ASCII.
+    const char *(*find_string_end)(const char *p, const char *end, char quote);
+    // Skip [A-Za-z0-9_] and [0-9_] runs.
+    const char *(*skip_ident)(const char *p, const char *end);
+    const char *(*skip_digits)(const char *p, const char *end);
+    // Unlike the others, collects every '\n' in [p, end): stores `base`
+    // plus the offset from `p` of the byte after each into `out`, which
+    // must have room for end - p entries, and returns how many there were.
+    size_t (*index_lines)(const char *p, const char *end, uint32_t base, uint32_t *out);
+    // Finds the first character in [p, end) that is not well-formed UTF-8;
+    // `p` must start a character.
+    const char *(*find_invalid_utf8)(const char *p, const char *end);
+} ScanKernels;
+
+extern ScanKernels scan;
+
+// Switches to the kernels called `name` ("scalar", "sse2" or "avx2").
+// Returns false if they are not supported here.
+bool scan_use(const char *name);
+
+#endif // SCAN_H
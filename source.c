@@ -0,0 +1,94 @@
+#include "source.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "common.h"
+
+#define SOURCE_BLOCK (64 * 1024)
+
+static bool source_map(Source *src, int fd, size_t len)
+{
+    void *data = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) return false;
+
+    madvise(data, len, MADV_SEQUENTIAL);
+    madvise(data, len, MADV_WILLNEED);
+
+    src->data = data;
+    src->len = len;
+    src->mapped = true;
+    return true;
+}
+
+bool source_open(Source *src, const char *path)
+{
+    if (!strcmp(path, "-")) {
+        source_read(src, stdin);
+        return true;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        int err = errno;
+        close(fd);
+        errno = err;
+        return false;
+    }
+
+    // Empty files cannot be mapped, and the size of anything that is not a
+    // regular file is meaningless, so those go through stdio.
+    if (S_ISREG(st.st_mode) && st.st_size > 0 && source_map(src, fd, st.st_size)) {
+        close(fd);
+        return true;
+    }
+
+    FILE *f = fdopen(fd, "r");
+    if (!f) {
+        int err = errno;
+        close(fd);
+        errno = err;
+        return false;
+    }
+    source_read(src, f);
+    fclose(f);
+    return true;
+}
+
+void source_read(Source *src, FILE *f)
+{
+    size_t cap = SOURCE_BLOCK;
+    size_t len = 0;
+    char *data = malloc(cap);
+    if (!data) PANIC("Out of memory");
+
+    for (;;) {
+        if (cap - len < SOURCE_BLOCK) {
+            data = realloc(data, cap *= 2);
+            if (!data) PANIC("Out of memory");
+        }
+        size_t n = fread(data + len, 1, cap - len, f);
+        len += n;
+        if (n == 0) break;
+    }
+    if (ferror(f)) PANIC("Cannot read file: %m");
+
+    src->data = data;
+    src->len = len;
+    src->mapped = false;
+}
+
+void source_free(Source *src)
+{
+    if (src->mapped) munmap((void *)src->data, src->len);
+    else free((void *)src->data);
+    src->data = NULL;
+    src->len = 0;
+}
@@ -0,0 +1,24 @@
+#ifndef SOURCE_H
+#define SOURCE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// The whole input of a compilation unit as one contiguous read-only buffer,
+// so the lexer can scan it with plain pointer arithmetic.  Regular files are
+// memory-mapped; anything else (pipes, terminals, stdin) is read into a heap
+// buffer.
+typedef struct {
+    const char *data;
+    size_t len;
+    bool mapped;
+} Source;
+
+// Opens `path`, or stdin when `path` is "-".  Returns false and sets errno
+// on failure.
+bool source_open(Source *src, const char *path);
+void source_read(Source *src, FILE *f);
+void source_free(Source *src);
+
+#endif // SOURCE_H
@@ -0,0 +1,163 @@
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "source.h"
+#include "tokbin.h"
+
+#define TOKBIN_BLOCK (1024 * 1024)
+// The most one token can take: type, two 5-byte varints and a 10-byte one.
+#define TOKBIN_MAX_TOKEN (1 + 5 + 5 + 10)
+
+static uint8_t *put_varint(uint8_t *p, uint64_t v)
+{
+    while (v >= 0x80) {
+        *p++ = v | 0x80;
+        v >>= 7;
+    }
+    *p++ = v;
+    return p;
+}
+
+static bool write_all(int fd, const uint8_t *p, size_t len)
+{
+    while (len) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += n;
+        len -= n;
+    }
+    return true;
+}
+
+bool tokbin_write(int fd, const TokenStream *ts)
+{
+    uint8_t *buf = malloc(TOKBIN_BLOCK);
+    if (!buf) PANIC("Out of memory");
+
+    uint8_t *p = buf;
+    memcpy(p, TOKBIN_MAGIC, 4);
+    p += 4;
+    *p++ = TOKBIN_VERSION;
+    p = put_varint(p, ts->count);
+    p = put_varint(p, ts->value_count);
+
+    bool ok = true;
+    uint32_t prev = 0;
+    size_t value = 0;
+    for (size_t i = 0; i < ts->count && ok; i++) {
+        if (p - buf > TOKBIN_BLOCK - TOKBIN_MAX_TOKEN) {
+            ok = write_all(fd, buf, p - buf);
+            p = buf;
+        }
+
+        uint8_t type = ts->types[i];
+        *p++ = type;
+        p = put_varint(p, ts->offsets[i] - prev);
+        p = put_varint(p, ts->lens[i]);
+        prev = ts->offsets[i];
+        if (!token_has_value(type)) continue;
+
+        TokenValue v = ts->values[value++];
+        switch (type) {
+            case TOK_NUMBER: p = put_varint(p, v.number_value); break;
+            case TOK_IDENT: p = put_varint(p, v.ident); break;
+            case TOK_ERROR: p = put_varint(p, v.error); break;
+            case TOK_STRING: *p++ = v.has_escapes; break;
+            case TOK_FLOAT: {
+                uint64_t bits;
+                memcpy(&bits, &v.float_value, sizeof(bits));
+                for (int b = 0; b < 8; b++) *p++ = bits >> (8 * b);
+            } break;
+        }
+    }
+    if (ok) ok = write_all(fd, buf, p - buf);
+
+    free(buf);
+    return ok;
+}
+
+static bool get_varint(const uint8_t **p, const uint8_t *end, uint64_t *v)
+{
+    *v = 0;
+    for (int shift = 0; *p < end && shift < 64; shift += 7) {
+        uint8_t b = *(*p)++;
+        *v |= (uint64_t)(b & 0x7f) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+bool tokbin_decode(const char *data, size_t len, TokenStream *ts)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    const uint8_t *end = p + len;
+    if (len < 5 || memcmp(p, TOKBIN_MAGIC, 4) || p[4] != TOKBIN_VERSION) return false;
+    p += 5;
+
+    uint64_t count, values;
+    if (!get_varint(&p, end, &count) || !get_varint(&p, end, &values)) return false;
+    // Every token takes at least three bytes, which bounds a bogus count.
+    if (count > (size_t)(end - p) / 3 || values > count) return false;
+    token_stream_reserve(ts, ts->count + count, ts->value_count + values);
+
+    uint32_t offset = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t delta, tok_len;
+        if (p >= end || *p >= _TOK_COUNT) return false;
+        uint8_t type = *p++;
+        if (!get_varint(&p, end, &delta) || !get_varint(&p, end, &tok_len)) return false;
+        if (delta > UINT32_MAX - offset || tok_len > UINT32_MAX) return false;
+        offset += delta;
+
+        ts->types[ts->count] = type;
+        ts->offsets[ts->count] = offset;
+        ts->lens[ts->count] = tok_len;
+        ts->count++;
+        if (!token_has_value(type)) continue;
+
+        if (ts->value_count == ts->value_cap) return false;
+        TokenValue *v = &ts->values[ts->value_count++];
+        *v = (TokenValue){ 0 };
+        uint64_t n;
+        switch (type) {
+            case TOK_NUMBER:
+                if (!get_varint(&p, end, &n)) return false;
+                v->number_value = n;
+                break;
+            case TOK_IDENT:
+                if (!get_varint(&p, end, &n)) return false;
+                v->ident = n;
+                break;
+            case TOK_ERROR:
+                if (!get_varint(&p, end, &n)) return false;
+                v->error = n;
+                break;
+            case TOK_STRING:
+                if (p >= end) return false;
+                v->has_escapes = *p++;
+                break;
+            case TOK_FLOAT: {
+                if (end - p < 8) return false;
+                uint64_t bits = 0;
+                for (int b = 0; b < 8; b++) bits |= (uint64_t)*p++ << (8 * b);
+                memcpy(&v->float_value, &bits, sizeof(bits));
+            } break;
+        }
+    }
+    return p == end;
+}
+
+bool tokbin_load(const char *path, TokenStream *ts)
+{
+    Source src;
+    if (!source_open(&src, path)) return false;
+    bool ok = tokbin_decode(src.data, src.len, ts);
+    source_free(&src);
+    return ok;
+}
@@ -0,0 +1,26 @@
+#ifndef TOKBIN_H
+#define TOKBIN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "lexer.h"
+
+// A compact binary form of a token stream for other tools.  After a header
+// ("TOKB", a version byte and varint token and value counts) each token is
+// its type byte, the varint distance of its offset from the previous
+// token's, its varint length and, for tokens with one, its value: a varint
+// for numbers, identifier ids and error codes, 8 little-endian bytes for
+// floats and a byte for whether a string has escapes.  Varints are LEB128.
+#define TOKBIN_MAGIC "TOKB"
+#define TOKBIN_VERSION 2
+
+// Writes `ts` to `fd` in large blocks.  Returns false and sets errno if a
+// write fails.
+bool tokbin_write(int fd, const TokenStream *ts);
+// Decodes a whole file into `ts`; the file is memory-mapped when it can
+// be.  Returns false if it cannot be read or is not a valid token stream.
+bool tokbin_load(const char *path, TokenStream *ts);
+bool tokbin_decode(const char *data, size_t len, TokenStream *ts);
+
+#endif // TOKBIN_H
@@ -0,0 +1,32 @@
+#ifndef TOKENS_H
+#define TOKENS_H
+
+// The punctuators; the longest that matches wins.  They expand into the
+// punctuator members of TokenType and their names[] entries, and gen_dfa
+// turns them and LINE_COMMENT into the minimized DFA in dfa.gen.h that
+// next_token runs on any byte that starts one.  Identifiers, numbers and
+// strings have their own scanners, and keywords are in keywords.h.
+// X(NAME, text)
+#define PUNCTUATORS(X)              \
+    X(PLUS, "+")                    \
+    X(MINUS, "-")                   \
+    X(LPAREN, "(")                  \
+    X(RPAREN, ")")                  \
+    X(LBRACE, "{")                  \
+    X(RBRACE, "}")                  \
+    X(LBRACKET, "[")                \
+    X(RBRACKET, "]")                \
+    X(SEMICOLON, ";")               \
+    X(EQUALS, "=")                  \
+    X(EQUALS_EQUALS, "==")          \
+    X(BANG, "!")                    \
+    X(BANG_EQUALS, "!=")            \
+    X(LESS, "<")                    \
+    X(LESS_EQUALS, "<=")            \
+    X(GREATER, ">")                 \
+    X(GREATER_EQUALS, ">=")         \
+
+// Starts a comment that runs to the end of the line.
+#define LINE_COMMENT "//"
+
+#endif // TOKENS_H
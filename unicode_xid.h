@@ -0,0 +1,365 @@
+#ifndef UNICODE_XID_H
+#define UNICODE_XID_H
+
+// The code points above ASCII with the XID_Start and XID_Continue properties,
+// from DerivedCoreProperties.txt of Unicode 14.0.0, as inclusive ranges.
+// gen_xid turns them into the bitmaps in xid.gen.h.  X(first, last)
+#define XID_START_RANGES(X) \
+    X(0x00AA, 0x00AA) X(0x00B5, 0x00B5) X(0x00BA, 0x00BA) X(0x00C0, 0x00D6) \
+    X(0x00D8, 0x00F6) X(0x00F8, 0x02C1) X(0x02C6, 0x02D1) X(0x02E0, 0x02E4) \
+    X(0x02EC, 0x02EC) X(0x02EE, 0x02EE) X(0x0370, 0x0374) X(0x0376, 0x0377) \
+    X(0x037B, 0x037D) X(0x037F, 0x037F) X(0x0386, 0x0386) X(0x0388, 0x038A) \
+    X(0x038C, 0x038C) X(0x038E, 0x03A1) X(0x03A3, 0x03F5) X(0x03F7, 0x0481) \
+    X(0x048A, 0x052F) X(0x0531, 0x0556) X(0x0559, 0x0559) X(0x0560, 0x0588) \
+    X(0x05D0, 0x05EA) X(0x05EF, 0x05F2) X(0x0620, 0x064A) X(0x066E, 0x066F) \
+    X(0x0671, 0x06D3) X(0x06D5, 0x06D5) X(0x06E5, 0x06E6) X(0x06EE, 0x06EF) \
+    X(0x06FA, 0x06FC) X(0x06FF, 0x06FF) X(0x0710, 0x0710) X(0x0712, 0x072F) \
+    X(0x074D, 0x07A5) X(0x07B1, 0x07B1) X(0x07CA, 0x07EA) X(0x07F4, 0x07F5) \
+    X(0x07FA, 0x07FA) X(0x0800, 0x0815) X(0x081A, 0x081A) X(0x0824, 0x0824) \
+    X(0x0828, 0x0828) X(0x0840, 0x0858) X(0x0860, 0x086A) X(0x0870, 0x0887) \
+    X(0x0889, 0x088E) X(0x08A0, 0x08C9) X(0x0904, 0x0939) X(0x093D, 0x093D) \
+    X(0x0950, 0x0950) X(0x0958, 0x0961) X(0x0971, 0x0980) X(0x0985, 0x098C) \
+    X(0x098F, 0x0990) X(0x0993, 0x09A8) X(0x09AA, 0x09B0) X(0x09B2, 0x09B2) \
+    X(0x09B6, 0x09B9) X(0x09BD, 0x09BD) X(0x09CE, 0x09CE) X(0x09DC, 0x09DD) \
+    X(0x09DF, 0x09E1) X(0x09F0, 0x09F1) X(0x09FC, 0x09FC) X(0x0A05, 0x0A0A) \
+    X(0x0A0F, 0x0A10) X(0x0A13, 0x0A28) X(0x0A2A, 0x0A30) X(0x0A32, 0x0A33) \
+    X(0x0A35, 0x0A36) X(0x0A38, 0x0A39) X(0x0A59, 0x0A5C) X(0x0A5E, 0x0A5E) \
+    X(0x0A72, 0x0A74) X(0x0A85, 0x0A8D) X(0x0A8F, 0x0A91) X(0x0A93, 0x0AA8) \
+    X(0x0AAA, 0x0AB0) X(0x0AB2, 0x0AB3) X(0x0AB5, 0x0AB9) X(0x0ABD, 0x0ABD) \
+    X(0x0AD0, 0x0AD0) X(0x0AE0, 0x0AE1) X(0x0AF9, 0x0AF9) X(0x0B05, 0x0B0C) \
+    X(0x0B0F, 0x0B10) X(0x0B13, 0x0B28) X(0x0B2A, 0x0B30) X(0x0B32, 0x0B33) \
+    X(0x0B35, 0x0B39) X(0x0B3D, 0x0B3D) X(0x0B5C, 0x0B5D) X(0x0B5F, 0x0B61) \
+    X(0x0B71, 0x0B71) X(0x0B83, 0x0B83) X(0x0B85, 0x0B8A) X(0x0B8E, 0x0B90) \
+    X(0x0B92, 0x0B95) X(0x0B99, 0x0B9A) X(0x0B9C, 0x0B9C) X(0x0B9E, 0x0B9F) \
+    X(0x0BA3, 0x0BA4) X(0x0BA8, 0x0BAA) X(0x0BAE, 0x0BB9) X(0x0BD0, 0x0BD0) \
+    X(0x0C05, 0x0C0C) X(0x0C0E, 0x0C10) X(0x0C12, 0x0C28) X(0x0C2A, 0x0C39) \
+    X(0x0C3D, 0x0C3D) X(0x0C58, 0x0C5A) X(0x0C5D, 0x0C5D) X(0x0C60, 0x0C61) \
+    X(0x0C80, 0x0C80) X(0x0C85, 0x0C8C) X(0x0C8E, 0x0C90) X(0x0C92, 0x0CA8) \
+    X(0x0CAA, 0x0CB3) X(0x0CB5, 0x0CB9) X(0x0CBD, 0x0CBD) X(0x0CDD, 0x0CDE) \
+    X(0x0CE0, 0x0CE1) X(0x0CF1, 0x0CF2) X(0x0D04, 0x0D0C) X(0x0D0E, 0x0D10) \
+    X(0x0D12, 0x0D3A) X(0x0D3D, 0x0D3D) X(0x0D4E, 0x0D4E) X(0x0D54, 0x0D56) \
+    X(0x0D5F, 0x0D61) X(0x0D7A, 0x0D7F) X(0x0D85, 0x0D96) X(0x0D9A, 0x0DB1) \
+    X(0x0DB3, 0x0DBB) X(0x0DBD, 0x0DBD) X(0x0DC0, 0x0DC6) X(0x0E01, 0x0E30) \
+    X(0x0E32, 0x0E32) X(0x0E40, 0x0E46) X(0x0E81, 0x0E82) X(0x0E84, 0x0E84) \
+    X(0x0E86, 0x0E8A) X(0x0E8C, 0x0EA3) X(0x0EA5, 0x0EA5) X(0x0EA7, 0x0EB0) \
+    X(0x0EB2, 0x0EB2) X(0x0EBD, 0x0EBD) X(0x0EC0, 0x0EC4) X(0x0EC6, 0x0EC6) \
+    X(0x0EDC, 0x0EDF) X(0x0F00, 0x0F00) X(0x0F40, 0x0F47) X(0x0F49, 0x0F6C) \
+    X(0x0F88, 0x0F8C) X(0x1000, 0x102A) X(0x103F, 0x103F) X(0x1050, 0x1055) \
+    X(0x105A, 0x105D) X(0x1061, 0x1061) X(0x1065, 0x1066) X(0x106E, 0x1070) \
+    X(0x1075, 0x1081) X(0x108E, 0x108E) X(0x10A0, 0x10C5) X(0x10C7, 0x10C7) \
+    X(0x10CD, 0x10CD) X(0x10D0, 0x10FA) X(0x10FC, 0x1248) X(0x124A, 0x124D) \
+    X(0x1250, 0x1256) X(0x1258, 0x1258) X(0x125A, 0x125D) X(0x1260, 0x1288) \
+    X(0x128A, 0x128D) X(0x1290, 0x12B0) X(0x12B2, 0x12B5) X(0x12B8, 0x12BE) \
+    X(0x12C0, 0x12C0) X(0x12C2, 0x12C5) X(0x12C8, 0x12D6) X(0x12D8, 0x1310) \
+    X(0x1312, 0x1315) X(0x1318, 0x135A) X(0x1380, 0x138F) X(0x13A0, 0x13F5) \
+    X(0x13F8, 0x13FD) X(0x1401, 0x166C) X(0x166F, 0x167F) X(0x1681, 0x169A) \
+    X(0x16A0, 0x16EA) X(0x16EE, 0x16F8) X(0x1700, 0x1711) X(0x171F, 0x1731) \
+    X(0x1740, 0x1751) X(0x1760, 0x176C) X(0x176E, 0x1770) X(0x1780, 0x17B3) \
+    X(0x17D7, 0x17D7) X(0x17DC, 0x17DC) X(0x1820, 0x1878) X(0x1880, 0x18A8) \
+    X(0x18AA, 0x18AA) X(0x18B0, 0x18F5) X(0x1900, 0x191E) X(0x1950, 0x196D) \
+    X(0x1970, 0x1974) X(0x1980, 0x19AB) X(0x19B0, 0x19C9) X(0x1A00, 0x1A16) \
+    X(0x1A20, 0x1A54) X(0x1AA7, 0x1AA7) X(0x1B05, 0x1B33) X(0x1B45, 0x1B4C) \
+    X(0x1B83, 0x1BA0) X(0x1BAE, 0x1BAF) X(0x1BBA, 0x1BE5) X(0x1C00, 0x1C23) \
+    X(0x1C4D, 0x1C4F) X(0x1C5A, 0x1C7D) X(0x1C80, 0x1C88) X(0x1C90, 0x1CBA) \
+    X(0x1CBD, 0x1CBF) X(0x1CE9, 0x1CEC) X(0x1CEE, 0x1CF3) X(0x1CF5, 0x1CF6) \
+    X(0x1CFA, 0x1CFA) X(0x1D00, 0x1DBF) X(0x1E00, 0x1F15) X(0x1F18, 0x1F1D) \
+    X(0x1F20, 0x1F45) X(0x1F48, 0x1F4D) X(0x1F50, 0x1F57) X(0x1F59, 0x1F59) \
+    X(0x1F5B, 0x1F5B) X(0x1F5D, 0x1F5D) X(0x1F5F, 0x1F7D) X(0x1F80, 0x1FB4) \
+    X(0x1FB6, 0x1FBC) X(0x1FBE, 0x1FBE) X(0x1FC2, 0x1FC4) X(0x1FC6, 0x1FCC) \
+    X(0x1FD0, 0x1FD3) X(0x1FD6, 0x1FDB) X(0x1FE0, 0x1FEC) X(0x1FF2, 0x1FF4) \
+    X(0x1FF6, 0x1FFC) X(0x2071, 0x2071) X(0x207F, 0x207F) X(0x2090, 0x209C) \
+    X(0x2102, 0x2102) X(0x2107, 0x2107) X(0x210A, 0x2113) X(0x2115, 0x2115) \
+    X(0x2118, 0x211D) X(0x2124, 0x2124) X(0x2126, 0x2126) X(0x2128, 0x2128) \
+    X(0x212A, 0x2139) X(0x213C, 0x213F) X(0x2145, 0x2149) X(0x214E, 0x214E) \
+    X(0x2160, 0x2188) X(0x2C00, 0x2CE4) X(0x2CEB, 0x2CEE) X(0x2CF2, 0x2CF3) \
+    X(0x2D00, 0x2D25) X(0x2D27, 0x2D27) X(0x2D2D, 0x2D2D) X(0x2D30, 0x2D67) \
+    X(0x2D6F, 0x2D6F) X(0x2D80, 0x2D96) X(0x2DA0, 0x2DA6) X(0x2DA8, 0x2DAE) \
+    X(0x2DB0, 0x2DB6) X(0x2DB8, 0x2DBE) X(0x2DC0, 0x2DC6) X(0x2DC8, 0x2DCE) \
+    X(0x2DD0, 0x2DD6) X(0x2DD8, 0x2DDE) X(0x3005, 0x3007) X(0x3021, 0x3029) \
+    X(0x3031, 0x3035) X(0x3038, 0x303C) X(0x3041, 0x3096) X(0x309D, 0x309F) \
+    X(0x30A1, 0x30FA) X(0x30FC, 0x30FF) X(0x3105, 0x312F) X(0x3131, 0x318E) \
+    X(0x31A0, 0x31BF) X(0x31F0, 0x31FF) X(0x3400, 0x4DBF) X(0x4E00, 0xA48C) \
+    X(0xA4D0, 0xA4FD) X(0xA500, 0xA60C) X(0xA610, 0xA61F) X(0xA62A, 0xA62B) \
+    X(0xA640, 0xA66E) X(0xA67F, 0xA69D) X(0xA6A0, 0xA6EF) X(0xA717, 0xA71F) \
+    X(0xA722, 0xA788) X(0xA78B, 0xA7CA) X(0xA7D0, 0xA7D1) X(0xA7D3, 0xA7D3) \
+    X(0xA7D5, 0xA7D9) X(0xA7F2, 0xA801) X(0xA803, 0xA805) X(0xA807, 0xA80A) \
+    X(0xA80C, 0xA822) X(0xA840, 0xA873) X(0xA882, 0xA8B3) X(0xA8F2, 0xA8F7) \
+    X(0xA8FB, 0xA8FB) X(0xA8FD, 0xA8FE) X(0xA90A, 0xA925) X(0xA930, 0xA946) \
+    X(0xA960, 0xA97C) X(0xA984, 0xA9B2) X(0xA9CF, 0xA9CF) X(0xA9E0, 0xA9E4) \
+    X(0xA9E6, 0xA9EF) X(0xA9FA, 0xA9FE) X(0xAA00, 0xAA28) X(0xAA40, 0xAA42) \
+    X(0xAA44, 0xAA4B) X(0xAA60, 0xAA76) X(0xAA7A, 0xAA7A) X(0xAA7E, 0xAAAF) \
+    X(0xAAB1, 0xAAB1) X(0xAAB5, 0xAAB6) X(0xAAB9, 0xAABD) X(0xAAC0, 0xAAC0) \
+    X(0xAAC2, 0xAAC2) X(0xAADB, 0xAADD) X(0xAAE0, 0xAAEA) X(0xAAF2, 0xAAF4) \
+    X(0xAB01, 0xAB06) X(0xAB09, 0xAB0E) X(0xAB11, 0xAB16) X(0xAB20, 0xAB26) \
+    X(0xAB28, 0xAB2E) X(0xAB30, 0xAB5A) X(0xAB5C, 0xAB69) X(0xAB70, 0xABE2) \
+    X(0xAC00, 0xD7A3) X(0xD7B0, 0xD7C6) X(0xD7CB, 0xD7FB) X(0xF900, 0xFA6D) \
+    X(0xFA70, 0xFAD9) X(0xFB00, 0xFB06) X(0xFB13, 0xFB17) X(0xFB1D, 0xFB1D) \
+    X(0xFB1F, 0xFB28) X(0xFB2A, 0xFB36) X(0xFB38, 0xFB3C) X(0xFB3E, 0xFB3E) \
+    X(0xFB40, 0xFB41) X(0xFB43, 0xFB44) X(0xFB46, 0xFBB1) X(0xFBD3, 0xFC5D) \
+    X(0xFC64, 0xFD3D) X(0xFD50, 0xFD8F) X(0xFD92, 0xFDC7) X(0xFDF0, 0xFDF9) \
+    X(0xFE71, 0xFE71) X(0xFE73, 0xFE73) X(0xFE77, 0xFE77) X(0xFE79, 0xFE79) \
+    X(0xFE7B, 0xFE7B) X(0xFE7D, 0xFE7D) X(0xFE7F, 0xFEFC) X(0xFF21, 0xFF3A) \
+    X(0xFF41, 0xFF5A) X(0xFF66, 0xFF9D) X(0xFFA0, 0xFFBE) X(0xFFC2, 0xFFC7) \
+    X(0xFFCA, 0xFFCF) X(0xFFD2, 0xFFD7) X(0xFFDA, 0xFFDC) X(0x10000, 0x1000B)\
+    X(0x1000D, 0x10026) X(0x10028, 0x1003A) X(0x1003C, 0x1003D) X(0x1003F, 0x1004D)\
+    X(0x10050, 0x1005D) X(0x10080, 0x100FA) X(0x10140, 0x10174) X(0x10280, 0x1029C)\
+    X(0x102A0, 0x102D0) X(0x10300, 0x1031F) X(0x1032D, 0x1034A) X(0x10350, 0x10375)\
+    X(0x10380, 0x1039D) X(0x103A0, 0x103C3) X(0x103C8, 0x103CF) X(0x103D1, 0x103D5)\
+    X(0x10400, 0x1049D) X(0x104B0, 0x104D3) X(0x104D8, 0x104FB) X(0x10500, 0x10527)\
+    X(0x10530, 0x10563) X(0x10570, 0x1057A) X(0x1057C, 0x1058A) X(0x1058C, 0x10592)\
+    X(0x10594, 0x10595) X(0x10597, 0x105A1) X(0x105A3, 0x105B1) X(0x105B3, 0x105B9)\
+    X(0x105BB, 0x105BC) X(0x10600, 0x10736) X(0x10740, 0x10755) X(0x10760, 0x10767)\
+    X(0x10780, 0x10785) X(0x10787, 0x107B0) X(0x107B2, 0x107BA) X(0x10800, 0x10805)\
+    X(0x10808, 0x10808) X(0x1080A, 0x10835) X(0x10837, 0x10838) X(0x1083C, 0x1083C)\
+    X(0x1083F, 0x10855) X(0x10860, 0x10876) X(0x10880, 0x1089E) X(0x108E0, 0x108F2)\
+    X(0x108F4, 0x108F5) X(0x10900, 0x10915) X(0x10920, 0x10939) X(0x10980, 0x109B7)\
+    X(0x109BE, 0x109BF) X(0x10A00, 0x10A00) X(0x10A10, 0x10A13) X(0x10A15, 0x10A17)\
+    X(0x10A19, 0x10A35) X(0x10A60, 0x10A7C) X(0x10A80, 0x10A9C) X(0x10AC0, 0x10AC7)\
+    X(0x10AC9, 0x10AE4) X(0x10B00, 0x10B35) X(0x10B40, 0x10B55) X(0x10B60, 0x10B72)\
+    X(0x10B80, 0x10B91) X(0x10C00, 0x10C48) X(0x10C80, 0x10CB2) X(0x10CC0, 0x10CF2)\
+    X(0x10D00, 0x10D23) X(0x10E80, 0x10EA9) X(0x10EB0, 0x10EB1) X(0x10F00, 0x10F1C)\
+    X(0x10F27, 0x10F27) X(0x10F30, 0x10F45) X(0x10F70, 0x10F81) X(0x10FB0, 0x10FC4)\
+    X(0x10FE0, 0x10FF6) X(0x11003, 0x11037) X(0x11071, 0x11072) X(0x11075, 0x11075)\
+    X(0x11083, 0x110AF) X(0x110D0, 0x110E8) X(0x11103, 0x11126) X(0x11144, 0x11144)\
+    X(0x11147, 0x11147) X(0x11150, 0x11172) X(0x11176, 0x11176) X(0x11183, 0x111B2)\
+    X(0x111C1, 0x111C4) X(0x111DA, 0x111DA) X(0x111DC, 0x111DC) X(0x11200, 0x11211)\
+    X(0x11213, 0x1122B) X(0x11280, 0x11286) X(0x11288, 0x11288) X(0x1128A, 0x1128D)\
+    X(0x1128F, 0x1129D) X(0x1129F, 0x112A8) X(0x112B0, 0x112DE) X(0x11305, 0x1130C)\
+    X(0x1130F, 0x11310) X(0x11313, 0x11328) X(0x1132A, 0x11330) X(0x11332, 0x11333)\
+    X(0x11335, 0x11339) X(0x1133D, 0x1133D) X(0x11350, 0x11350) X(0x1135D, 0x11361)\
+    X(0x11400, 0x11434) X(0x11447, 0x1144A) X(0x1145F, 0x11461) X(0x11480, 0x114AF)\
+    X(0x114C4, 0x114C5) X(0x114C7, 0x114C7) X(0x11580, 0x115AE) X(0x115D8, 0x115DB)\
+    X(0x11600, 0x1162F) X(0x11644, 0x11644) X(0x11680, 0x116AA) X(0x116B8, 0x116B8)\
+    X(0x11700, 0x1171A) X(0x11740, 0x11746) X(0x11800, 0x1182B) X(0x118A0, 0x118DF)\
+    X(0x118FF, 0x11906) X(0x11909, 0x11909) X(0x1190C, 0x11913) X(0x11915, 0x11916)\
+    X(0x11918, 0x1192F) X(0x1193F, 0x1193F) X(0x11941, 0x11941) X(0x119A0, 0x119A7)\
+    X(0x119AA, 0x119D0) X(0x119E1, 0x119E1) X(0x119E3, 0x119E3) X(0x11A00, 0x11A00)\
+    X(0x11A0B, 0x11A32) X(0x11A3A, 0x11A3A) X(0x11A50, 0x11A50) X(0x11A5C, 0x11A89)\
+    X(0x11A9D, 0x11A9D) X(0x11AB0, 0x11AF8) X(0x11C00, 0x11C08) X(0x11C0A, 0x11C2E)\
+    X(0x11C40, 0x11C40) X(0x11C72, 0x11C8F) X(0x11D00, 0x11D06) X(0x11D08, 0x11D09)\
+    X(0x11D0B, 0x11D30) X(0x11D46, 0x11D46) X(0x11D60, 0x11D65) X(0x11D67, 0x11D68)\
+    X(0x11D6A, 0x11D89) X(0x11D98, 0x11D98) X(0x11EE0, 0x11EF2) X(0x11FB0, 0x11FB0)\
+    X(0x12000, 0x12399) X(0x12400, 0x1246E) X(0x12480, 0x12543) X(0x12F90, 0x12FF0)\
+    X(0x13000, 0x1342E) X(0x14400, 0x14646) X(0x16800, 0x16A38) X(0x16A40, 0x16A5E)\
+    X(0x16A70, 0x16ABE) X(0x16AD0, 0x16AED) X(0x16B00, 0x16B2F) X(0x16B40, 0x16B43)\
+    X(0x16B63, 0x16B77) X(0x16B7D, 0x16B8F) X(0x16E40, 0x16E7F) X(0x16F00, 0x16F4A)\
+    X(0x16F50, 0x16F50) X(0x16F93, 0x16F9F) X(0x16FE0, 0x16FE1) X(0x16FE3, 0x16FE3)\
+    X(0x17000, 0x187F7) X(0x18800, 0x18CD5) X(0x18D00, 0x18D08) X(0x1AFF0, 0x1AFF3)\
+    X(0x1AFF5, 0x1AFFB) X(0x1AFFD, 0x1AFFE) X(0x1B000, 0x1B122) X(0x1B150, 0x1B152)\
+    X(0x1B164, 0x1B167) X(0x1B170, 0x1B2FB) X(0x1BC00, 0x1BC6A) X(0x1BC70, 0x1BC7C)\
+    X(0x1BC80, 0x1BC88) X(0x1BC90, 0x1BC99) X(0x1D400, 0x1D454) X(0x1D456, 0x1D49C)\
+    X(0x1D49E, 0x1D49F) X(0x1D4A2, 0x1D4A2) X(0x1D4A5, 0x1D4A6) X(0x1D4A9, 0x1D4AC)\
+    X(0x1D4AE, 0x1D4B9) X(0x1D4BB, 0x1D4BB) X(0x1D4BD, 0x1D4C3) X(0x1D4C5, 0x1D505)\
+    X(0x1D507, 0x1D50A) X(0x1D50D, 0x1D514) X(0x1D516, 0x1D51C) X(0x1D51E, 0x1D539)\
+    X(0x1D53B, 0x1D53E) X(0x1D540, 0x1D544) X(0x1D546, 0x1D546) X(0x1D54A, 0x1D550)\
+    X(0x1D552, 0x1D6A5) X(0x1D6A8, 0x1D6C0) X(0x1D6C2, 0x1D6DA) X(0x1D6DC, 0x1D6FA)\
+    X(0x1D6FC, 0x1D714) X(0x1D716, 0x1D734) X(0x1D736, 0x1D74E) X(0x1D750, 0x1D76E)\
+    X(0x1D770, 0x1D788) X(0x1D78A, 0x1D7A8) X(0x1D7AA, 0x1D7C2) X(0x1D7C4, 0x1D7CB)\
+    X(0x1DF00, 0x1DF1E) X(0x1E100, 0x1E12C) X(0x1E137, 0x1E13D) X(0x1E14E, 0x1E14E)\
+    X(0x1E290, 0x1E2AD) X(0x1E2C0, 0x1E2EB) X(0x1E7E0, 0x1E7E6) X(0x1E7E8, 0x1E7EB)\
+    X(0x1E7ED, 0x1E7EE) X(0x1E7F0, 0x1E7FE) X(0x1E800, 0x1E8C4) X(0x1E900, 0x1E943)\
+    X(0x1E94B, 0x1E94B) X(0x1EE00, 0x1EE03) X(0x1EE05, 0x1EE1F) X(0x1EE21, 0x1EE22)\
+    X(0x1EE24, 0x1EE24) X(0x1EE27, 0x1EE27) X(0x1EE29, 0x1EE32) X(0x1EE34, 0x1EE37)\
+    X(0x1EE39, 0x1EE39) X(0x1EE3B, 0x1EE3B) X(0x1EE42, 0x1EE42) X(0x1EE47, 0x1EE47)\
+    X(0x1EE49, 0x1EE49) X(0x1EE4B, 0x1EE4B) X(0x1EE4D, 0x1EE4F) X(0x1EE51, 0x1EE52)\
+    X(0x1EE54, 0x1EE54) X(0x1EE57, 0x1EE57) X(0x1EE59, 0x1EE59) X(0x1EE5B, 0x1EE5B)\
+    X(0x1EE5D, 0x1EE5D) X(0x1EE5F, 0x1EE5F) X(0x1EE61, 0x1EE62) X(0x1EE64, 0x1EE64)\
+    X(0x1EE67, 0x1EE6A) X(0x1EE6C, 0x1EE72) X(0x1EE74, 0x1EE77) X(0x1EE79, 0x1EE7C)\
+    X(0x1EE7E, 0x1EE7E) X(0x1EE80, 0x1EE89) X(0x1EE8B, 0x1EE9B) X(0x1EEA1, 0x1EEA3)\
+    X(0x1EEA5, 0x1EEA9) X(0x1EEAB, 0x1EEBB) X(0x20000, 0x2A6DF) X(0x2A700, 0x2B738)\
+    X(0x2B740, 0x2B81D) X(0x2B820, 0x2CEA1) X(0x2CEB0, 0x2EBE0) X(0x2F800, 0x2FA1D)\
+    X(0x30000, 0x3134A)                                                     \
+
+#define XID_CONTINUE_RANGES(X) \
+    X(0x00AA, 0x00AA) X(0x00B5, 0x00B5) X(0x00B7, 0x00B7) X(0x00BA, 0x00BA) \
+    X(0x00C0, 0x00D6) X(0x00D8, 0x00F6) X(0x00F8, 0x02C1) X(0x02C6, 0x02D1) \
+    X(0x02E0, 0x02E4) X(0x02EC, 0x02EC) X(0x02EE, 0x02EE) X(0x0300, 0x0374) \
+    X(0x0376, 0x0377) X(0x037B, 0x037D) X(0x037F, 0x037F) X(0x0386, 0x038A) \
+    X(0x038C, 0x038C) X(0x038E, 0x03A1) X(0x03A3, 0x03F5) X(0x03F7, 0x0481) \
+    X(0x0483, 0x0487) X(0x048A, 0x052F) X(0x0531, 0x0556) X(0x0559, 0x0559) \
+    X(0x0560, 0x0588) X(0x0591, 0x05BD) X(0x05BF, 0x05BF) X(0x05C1, 0x05C2) \
+    X(0x05C4, 0x05C5) X(0x05C7, 0x05C7) X(0x05D0, 0x05EA) X(0x05EF, 0x05F2) \
+    X(0x0610, 0x061A) X(0x0620, 0x0669) X(0x066E, 0x06D3) X(0x06D5, 0x06DC) \
+    X(0x06DF, 0x06E8) X(0x06EA, 0x06FC) X(0x06FF, 0x06FF) X(0x0710, 0x074A) \
+    X(0x074D, 0x07B1) X(0x07C0, 0x07F5) X(0x07FA, 0x07FA) X(0x07FD, 0x07FD) \
+    X(0x0800, 0x082D) X(0x0840, 0x085B) X(0x0860, 0x086A) X(0x0870, 0x0887) \
+    X(0x0889, 0x088E) X(0x0898, 0x08E1) X(0x08E3, 0x0963) X(0x0966, 0x096F) \
+    X(0x0971, 0x0983) X(0x0985, 0x098C) X(0x098F, 0x0990) X(0x0993, 0x09A8) \
+    X(0x09AA, 0x09B0) X(0x09B2, 0x09B2) X(0x09B6, 0x09B9) X(0x09BC, 0x09C4) \
+    X(0x09C7, 0x09C8) X(0x09CB, 0x09CE) X(0x09D7, 0x09D7) X(0x09DC, 0x09DD) \
+    X(0x09DF, 0x09E3) X(0x09E6, 0x09F1) X(0x09FC, 0x09FC) X(0x09FE, 0x09FE) \
+    X(0x0A01, 0x0A03) X(0x0A05, 0x0A0A) X(0x0A0F, 0x0A10) X(0x0A13, 0x0A28) \
+    X(0x0A2A, 0x0A30) X(0x0A32, 0x0A33) X(0x0A35, 0x0A36) X(0x0A38, 0x0A39) \
+    X(0x0A3C, 0x0A3C) X(0x0A3E, 0x0A42) X(0x0A47, 0x0A48) X(0x0A4B, 0x0A4D) \
+    X(0x0A51, 0x0A51) X(0x0A59, 0x0A5C) X(0x0A5E, 0x0A5E) X(0x0A66, 0x0A75) \
+    X(0x0A81, 0x0A83) X(0x0A85, 0x0A8D) X(0x0A8F, 0x0A91) X(0x0A93, 0x0AA8) \
+    X(0x0AAA, 0x0AB0) X(0x0AB2, 0x0AB3) X(0x0AB5, 0x0AB9) X(0x0ABC, 0x0AC5) \
+    X(0x0AC7, 0x0AC9) X(0x0ACB, 0x0ACD) X(0x0AD0, 0x0AD0) X(0x0AE0, 0x0AE3) \
+    X(0x0AE6, 0x0AEF) X(0x0AF9, 0x0AFF) X(0x0B01, 0x0B03) X(0x0B05, 0x0B0C) \
+    X(0x0B0F, 0x0B10) X(0x0B13, 0x0B28) X(0x0B2A, 0x0B30) X(0x0B32, 0x0B33) \
+    X(0x0B35, 0x0B39) X(0x0B3C, 0x0B44) X(0x0B47, 0x0B48) X(0x0B4B, 0x0B4D) \
+    X(0x0B55, 0x0B57) X(0x0B5C, 0x0B5D) X(0x0B5F, 0x0B63) X(0x0B66, 0x0B6F) \
+    X(0x0B71, 0x0B71) X(0x0B82, 0x0B83) X(0x0B85, 0x0B8A) X(0x0B8E, 0x0B90) \
+    X(0x0B92, 0x0B95) X(0x0B99, 0x0B9A) X(0x0B9C, 0x0B9C) X(0x0B9E, 0x0B9F) \
+    X(0x0BA3, 0x0BA4) X(0x0BA8, 0x0BAA) X(0x0BAE, 0x0BB9) X(0x0BBE, 0x0BC2) \
+    X(0x0BC6, 0x0BC8) X(0x0BCA, 0x0BCD) X(0x0BD0, 0x0BD0) X(0x0BD7, 0x0BD7) \
+    X(0x0BE6, 0x0BEF) X(0x0C00, 0x0C0C) X(0x0C0E, 0x0C10) X(0x0C12, 0x0C28) \
+    X(0x0C2A, 0x0C39) X(0x0C3C, 0x0C44) X(0x0C46, 0x0C48) X(0x0C4A, 0x0C4D) \
+    X(0x0C55, 0x0C56) X(0x0C58, 0x0C5A) X(0x0C5D, 0x0C5D) X(0x0C60, 0x0C63) \
+    X(0x0C66, 0x0C6F) X(0x0C80, 0x0C83) X(0x0C85, 0x0C8C) X(0x0C8E, 0x0C90) \
+    X(0x0C92, 0x0CA8) X(0x0CAA, 0x0CB3) X(0x0CB5, 0x0CB9) X(0x0CBC, 0x0CC4) \
+    X(0x0CC6, 0x0CC8) X(0x0CCA, 0x0CCD) X(0x0CD5, 0x0CD6) X(0x0CDD, 0x0CDE) \
+    X(0x0CE0, 0x0CE3) X(0x0CE6, 0x0CEF) X(0x0CF1, 0x0CF2) X(0x0D00, 0x0D0C) \
+    X(0x0D0E, 0x0D10) X(0x0D12, 0x0D44) X(0x0D46, 0x0D48) X(0x0D4A, 0x0D4E) \
+    X(0x0D54, 0x0D57) X(0x0D5F, 0x0D63) X(0x0D66, 0x0D6F) X(0x0D7A, 0x0D7F) \
+    X(0x0D81, 0x0D83) X(0x0D85, 0x0D96) X(0x0D9A, 0x0DB1) X(0x0DB3, 0x0DBB) \
+    X(0x0DBD, 0x0DBD) X(0x0DC0, 0x0DC6) X(0x0DCA, 0x0DCA) X(0x0DCF, 0x0DD4) \
+    X(0x0DD6, 0x0DD6) X(0x0DD8, 0x0DDF) X(0x0DE6, 0x0DEF) X(0x0DF2, 0x0DF3) \
+    X(0x0E01, 0x0E3A) X(0x0E40, 0x0E4E) X(0x0E50, 0x0E59) X(0x0E81, 0x0E82) \
+    X(0x0E84, 0x0E84) X(0x0E86, 0x0E8A) X(0x0E8C, 0x0EA3) X(0x0EA5, 0x0EA5) \
+    X(0x0EA7, 0x0EBD) X(0x0EC0, 0x0EC4) X(0x0EC6, 0x0EC6) X(0x0EC8, 0x0ECD) \
+    X(0x0ED0, 0x0ED9) X(0x0EDC, 0x0EDF) X(0x0F00, 0x0F00) X(0x0F18, 0x0F19) \
+    X(0x0F20, 0x0F29) X(0x0F35, 0x0F35) X(0x0F37, 0x0F37) X(0x0F39, 0x0F39) \
+    X(0x0F3E, 0x0F47) X(0x0F49, 0x0F6C) X(0x0F71, 0x0F84) X(0x0F86, 0x0F97) \
+    X(0x0F99, 0x0FBC) X(0x0FC6, 0x0FC6) X(0x1000, 0x1049) X(0x1050, 0x109D) \
+    X(0x10A0, 0x10C5) X(0x10C7, 0x10C7) X(0x10CD, 0x10CD) X(0x10D0, 0x10FA) \
+    X(0x10FC, 0x1248) X(0x124A, 0x124D) X(0x1250, 0x1256) X(0x1258, 0x1258) \
+    X(0x125A, 0x125D) X(0x1260, 0x1288) X(0x128A, 0x128D) X(0x1290, 0x12B0) \
+    X(0x12B2, 0x12B5) X(0x12B8, 0x12BE) X(0x12C0, 0x12C0) X(0x12C2, 0x12C5) \
+    X(0x12C8, 0x12D6) X(0x12D8, 0x1310) X(0x1312, 0x1315) X(0x1318, 0x135A) \
+    X(0x135D, 0x135F) X(0x1369, 0x1371) X(0x1380, 0x138F) X(0x13A0, 0x13F5) \
+    X(0x13F8, 0x13FD) X(0x1401, 0x166C) X(0x166F, 0x167F) X(0x1681, 0x169A) \
+    X(0x16A0, 0x16EA) X(0x16EE, 0x16F8) X(0x1700, 0x1715) X(0x171F, 0x1734) \
+    X(0x1740, 0x1753) X(0x1760, 0x176C) X(0x176E, 0x1770) X(0x1772, 0x1773) \
+    X(0x1780, 0x17D3) X(0x17D7, 0x17D7) X(0x17DC, 0x17DD) X(0x17E0, 0x17E9) \
+    X(0x180B, 0x180D) X(0x180F, 0x1819) X(0x1820, 0x1878) X(0x1880, 0x18AA) \
+    X(0x18B0, 0x18F5) X(0x1900, 0x191E) X(0x1920, 0x192B) X(0x1930, 0x193B) \
+    X(0x1946, 0x196D) X(0x1970, 0x1974) X(0x1980, 0x19AB) X(0x19B0, 0x19C9) \
+    X(0x19D0, 0x19DA) X(0x1A00, 0x1A1B) X(0x1A20, 0x1A5E) X(0x1A60, 0x1A7C) \
+    X(0x1A7F, 0x1A89) X(0x1A90, 0x1A99) X(0x1AA7, 0x1AA7) X(0x1AB0, 0x1ABD) \
+    X(0x1ABF, 0x1ACE) X(0x1B00, 0x1B4C) X(0x1B50, 0x1B59) X(0x1B6B, 0x1B73) \
+    X(0x1B80, 0x1BF3) X(0x1C00, 0x1C37) X(0x1C40, 0x1C49) X(0x1C4D, 0x1C7D) \
+    X(0x1C80, 0x1C88) X(0x1C90, 0x1CBA) X(0x1CBD, 0x1CBF) X(0x1CD0, 0x1CD2) \
+    X(0x1CD4, 0x1CFA) X(0x1D00, 0x1F15) X(0x1F18, 0x1F1D) X(0x1F20, 0x1F45) \
+    X(0x1F48, 0x1F4D) X(0x1F50, 0x1F57) X(0x1F59, 0x1F59) X(0x1F5B, 0x1F5B) \
+    X(0x1F5D, 0x1F5D) X(0x1F5F, 0x1F7D) X(0x1F80, 0x1FB4) X(0x1FB6, 0x1FBC) \
+    X(0x1FBE, 0x1FBE) X(0x1FC2, 0x1FC4) X(0x1FC6, 0x1FCC) X(0x1FD0, 0x1FD3) \
+    X(0x1FD6, 0x1FDB) X(0x1FE0, 0x1FEC) X(0x1FF2, 0x1FF4) X(0x1FF6, 0x1FFC) \
+    X(0x203F, 0x2040) X(0x2054, 0x2054) X(0x2071, 0x2071) X(0x207F, 0x207F) \
+    X(0x2090, 0x209C) X(0x20D0, 0x20DC) X(0x20E1, 0x20E1) X(0x20E5, 0x20F0) \
+    X(0x2102, 0x2102) X(0x2107, 0x2107) X(0x210A, 0x2113) X(0x2115, 0x2115) \
+    X(0x2118, 0x211D) X(0x2124, 0x2124) X(0x2126, 0x2126) X(0x2128, 0x2128) \
+    X(0x212A, 0x2139) X(0x213C, 0x213F) X(0x2145, 0x2149) X(0x214E, 0x214E) \
+    X(0x2160, 0x2188) X(0x2C00, 0x2CE4) X(0x2CEB, 0x2CF3) X(0x2D00, 0x2D25) \
+    X(0x2D27, 0x2D27) X(0x2D2D, 0x2D2D) X(0x2D30, 0x2D67) X(0x2D6F, 0x2D6F) \
+    X(0x2D7F, 0x2D96) X(0x2DA0, 0x2DA6) X(0x2DA8, 0x2DAE) X(0x2DB0, 0x2DB6) \
+    X(0x2DB8, 0x2DBE) X(0x2DC0, 0x2DC6) X(0x2DC8, 0x2DCE) X(0x2DD0, 0x2DD6) \
+    X(0x2DD8, 0x2DDE) X(0x2DE0, 0x2DFF) X(0x3005, 0x3007) X(0x3021, 0x302F) \
+    X(0x3031, 0x3035) X(0x3038, 0x303C) X(0x3041, 0x3096) X(0x3099, 0x309A) \
+    X(0x309D, 0x309F) X(0x30A1, 0x30FA) X(0x30FC, 0x30FF) X(0x3105, 0x312F) \
+    X(0x3131, 0x318E) X(0x31A0, 0x31BF) X(0x31F0, 0x31FF) X(0x3400, 0x4DBF) \
+    X(0x4E00, 0xA48C) X(0xA4D0, 0xA4FD) X(0xA500, 0xA60C) X(0xA610, 0xA62B) \
+    X(0xA640, 0xA66F) X(0xA674, 0xA67D) X(0xA67F, 0xA6F1) X(0xA717, 0xA71F) \
+    X(0xA722, 0xA788) X(0xA78B, 0xA7CA) X(0xA7D0, 0xA7D1) X(0xA7D3, 0xA7D3) \
+    X(0xA7D5, 0xA7D9) X(0xA7F2, 0xA827) X(0xA82C, 0xA82C) X(0xA840, 0xA873) \
+    X(0xA880, 0xA8C5) X(0xA8D0, 0xA8D9) X(0xA8E0, 0xA8F7) X(0xA8FB, 0xA8FB) \
+    X(0xA8FD, 0xA92D) X(0xA930, 0xA953) X(0xA960, 0xA97C) X(0xA980, 0xA9C0) \
+    X(0xA9CF, 0xA9D9) X(0xA9E0, 0xA9FE) X(0xAA00, 0xAA36) X(0xAA40, 0xAA4D) \
+    X(0xAA50, 0xAA59) X(0xAA60, 0xAA76) X(0xAA7A, 0xAAC2) X(0xAADB, 0xAADD) \
+    X(0xAAE0, 0xAAEF) X(0xAAF2, 0xAAF6) X(0xAB01, 0xAB06) X(0xAB09, 0xAB0E) \
+    X(0xAB11, 0xAB16) X(0xAB20, 0xAB26) X(0xAB28, 0xAB2E) X(0xAB30, 0xAB5A) \
+    X(0xAB5C, 0xAB69) X(0xAB70, 0xABEA) X(0xABEC, 0xABED) X(0xABF0, 0xABF9) \
+    X(0xAC00, 0xD7A3) X(0xD7B0, 0xD7C6) X(0xD7CB, 0xD7FB) X(0xF900, 0xFA6D) \
+    X(0xFA70, 0xFAD9) X(0xFB00, 0xFB06) X(0xFB13, 0xFB17) X(0xFB1D, 0xFB28) \
+    X(0xFB2A, 0xFB36) X(0xFB38, 0xFB3C) X(0xFB3E, 0xFB3E) X(0xFB40, 0xFB41) \
+    X(0xFB43, 0xFB44) X(0xFB46, 0xFBB1) X(0xFBD3, 0xFC5D) X(0xFC64, 0xFD3D) \
+    X(0xFD50, 0xFD8F) X(0xFD92, 0xFDC7) X(0xFDF0, 0xFDF9) X(0xFE00, 0xFE0F) \
+    X(0xFE20, 0xFE2F) X(0xFE33, 0xFE34) X(0xFE4D, 0xFE4F) X(0xFE71, 0xFE71) \
+    X(0xFE73, 0xFE73) X(0xFE77, 0xFE77) X(0xFE79, 0xFE79) X(0xFE7B, 0xFE7B) \
+    X(0xFE7D, 0xFE7D) X(0xFE7F, 0xFEFC) X(0xFF10, 0xFF19) X(0xFF21, 0xFF3A) \
+    X(0xFF3F, 0xFF3F) X(0xFF41, 0xFF5A) X(0xFF66, 0xFFBE) X(0xFFC2, 0xFFC7) \
+    X(0xFFCA, 0xFFCF) X(0xFFD2, 0xFFD7) X(0xFFDA, 0xFFDC) X(0x10000, 0x1000B)\
+    X(0x1000D, 0x10026) X(0x10028, 0x1003A) X(0x1003C, 0x1003D) X(0x1003F, 0x1004D)\
+    X(0x10050, 0x1005D) X(0x10080, 0x100FA) X(0x10140, 0x10174) X(0x101FD, 0x101FD)\
+    X(0x10280, 0x1029C) X(0x102A0, 0x102D0) X(0x102E0, 0x102E0) X(0x10300, 0x1031F)\
+    X(0x1032D, 0x1034A) X(0x10350, 0x1037A) X(0x10380, 0x1039D) X(0x103A0, 0x103C3)\
+    X(0x103C8, 0x103CF) X(0x103D1, 0x103D5) X(0x10400, 0x1049D) X(0x104A0, 0x104A9)\
+    X(0x104B0, 0x104D3) X(0x104D8, 0x104FB) X(0x10500, 0x10527) X(0x10530, 0x10563)\
+    X(0x10570, 0x1057A) X(0x1057C, 0x1058A) X(0x1058C, 0x10592) X(0x10594, 0x10595)\
+    X(0x10597, 0x105A1) X(0x105A3, 0x105B1) X(0x105B3, 0x105B9) X(0x105BB, 0x105BC)\
+    X(0x10600, 0x10736) X(0x10740, 0x10755) X(0x10760, 0x10767) X(0x10780, 0x10785)\
+    X(0x10787, 0x107B0) X(0x107B2, 0x107BA) X(0x10800, 0x10805) X(0x10808, 0x10808)\
+    X(0x1080A, 0x10835) X(0x10837, 0x10838) X(0x1083C, 0x1083C) X(0x1083F, 0x10855)\
+    X(0x10860, 0x10876) X(0x10880, 0x1089E) X(0x108E0, 0x108F2) X(0x108F4, 0x108F5)\
+    X(0x10900, 0x10915) X(0x10920, 0x10939) X(0x10980, 0x109B7) X(0x109BE, 0x109BF)\
+    X(0x10A00, 0x10A03) X(0x10A05, 0x10A06) X(0x10A0C, 0x10A13) X(0x10A15, 0x10A17)\
+    X(0x10A19, 0x10A35) X(0x10A38, 0x10A3A) X(0x10A3F, 0x10A3F) X(0x10A60, 0x10A7C)\
+    X(0x10A80, 0x10A9C) X(0x10AC0, 0x10AC7) X(0x10AC9, 0x10AE6) X(0x10B00, 0x10B35)\
+    X(0x10B40, 0x10B55) X(0x10B60, 0x10B72) X(0x10B80, 0x10B91) X(0x10C00, 0x10C48)\
+    X(0x10C80, 0x10CB2) X(0x10CC0, 0x10CF2) X(0x10D00, 0x10D27) X(0x10D30, 0x10D39)\
+    X(0x10E80, 0x10EA9) X(0x10EAB, 0x10EAC) X(0x10EB0, 0x10EB1) X(0x10F00, 0x10F1C)\
+    X(0x10F27, 0x10F27) X(0x10F30, 0x10F50) X(0x10F70, 0x10F85) X(0x10FB0, 0x10FC4)\
+    X(0x10FE0, 0x10FF6) X(0x11000, 0x11046) X(0x11066, 0x11075) X(0x1107F, 0x110BA)\
+    X(0x110C2, 0x110C2) X(0x110D0, 0x110E8) X(0x110F0, 0x110F9) X(0x11100, 0x11134)\
+    X(0x11136, 0x1113F) X(0x11144, 0x11147) X(0x11150, 0x11173) X(0x11176, 0x11176)\
+    X(0x11180, 0x111C4) X(0x111C9, 0x111CC) X(0x111CE, 0x111DA) X(0x111DC, 0x111DC)\
+    X(0x11200, 0x11211) X(0x11213, 0x11237) X(0x1123E, 0x1123E) X(0x11280, 0x11286)\
+    X(0x11288, 0x11288) X(0x1128A, 0x1128D) X(0x1128F, 0x1129D) X(0x1129F, 0x112A8)\
+    X(0x112B0, 0x112EA) X(0x112F0, 0x112F9) X(0x11300, 0x11303) X(0x11305, 0x1130C)\
+    X(0x1130F, 0x11310) X(0x11313, 0x11328) X(0x1132A, 0x11330) X(0x11332, 0x11333)\
+    X(0x11335, 0x11339) X(0x1133B, 0x11344) X(0x11347, 0x11348) X(0x1134B, 0x1134D)\
+    X(0x11350, 0x11350) X(0x11357, 0x11357) X(0x1135D, 0x11363) X(0x11366, 0x1136C)\
+    X(0x11370, 0x11374) X(0x11400, 0x1144A) X(0x11450, 0x11459) X(0x1145E, 0x11461)\
+    X(0x11480, 0x114C5) X(0x114C7, 0x114C7) X(0x114D0, 0x114D9) X(0x11580, 0x115B5)\
+    X(0x115B8, 0x115C0) X(0x115D8, 0x115DD) X(0x11600, 0x11640) X(0x11644, 0x11644)\
+    X(0x11650, 0x11659) X(0x11680, 0x116B8) X(0x116C0, 0x116C9) X(0x11700, 0x1171A)\
+    X(0x1171D, 0x1172B) X(0x11730, 0x11739) X(0x11740, 0x11746) X(0x11800, 0x1183A)\
+    X(0x118A0, 0x118E9) X(0x118FF, 0x11906) X(0x11909, 0x11909) X(0x1190C, 0x11913)\
+    X(0x11915, 0x11916) X(0x11918, 0x11935) X(0x11937, 0x11938) X(0x1193B, 0x11943)\
+    X(0x11950, 0x11959) X(0x119A0, 0x119A7) X(0x119AA, 0x119D7) X(0x119DA, 0x119E1)\
+    X(0x119E3, 0x119E4) X(0x11A00, 0x11A3E) X(0x11A47, 0x11A47) X(0x11A50, 0x11A99)\
+    X(0x11A9D, 0x11A9D) X(0x11AB0, 0x11AF8) X(0x11C00, 0x11C08) X(0x11C0A, 0x11C36)\
+    X(0x11C38, 0x11C40) X(0x11C50, 0x11C59) X(0x11C72, 0x11C8F) X(0x11C92, 0x11CA7)\
+    X(0x11CA9, 0x11CB6) X(0x11D00, 0x11D06) X(0x11D08, 0x11D09) X(0x11D0B, 0x11D36)\
+    X(0x11D3A, 0x11D3A) X(0x11D3C, 0x11D3D) X(0x11D3F, 0x11D47) X(0x11D50, 0x11D59)\
+    X(0x11D60, 0x11D65) X(0x11D67, 0x11D68) X(0x11D6A, 0x11D8E) X(0x11D90, 0x11D91)\
+    X(0x11D93, 0x11D98) X(0x11DA0, 0x11DA9) X(0x11EE0, 0x11EF6) X(0x11FB0, 0x11FB0)\
+    X(0x12000, 0x12399) X(0x12400, 0x1246E) X(0x12480, 0x12543) X(0x12F90, 0x12FF0)\
+    X(0x13000, 0x1342E) X(0x14400, 0x14646) X(0x16800, 0x16A38) X(0x16A40, 0x16A5E)\
+    X(0x16A60, 0x16A69) X(0x16A70, 0x16ABE) X(0x16AC0, 0x16AC9) X(0x16AD0, 0x16AED)\
+    X(0x16AF0, 0x16AF4) X(0x16B00, 0x16B36) X(0x16B40, 0x16B43) X(0x16B50, 0x16B59)\
+    X(0x16B63, 0x16B77) X(0x16B7D, 0x16B8F) X(0x16E40, 0x16E7F) X(0x16F00, 0x16F4A)\
+    X(0x16F4F, 0x16F87) X(0x16F8F, 0x16F9F) X(0x16FE0, 0x16FE1) X(0x16FE3, 0x16FE4)\
+    X(0x16FF0, 0x16FF1) X(0x17000, 0x187F7) X(0x18800, 0x18CD5) X(0x18D00, 0x18D08)\
+    X(0x1AFF0, 0x1AFF3) X(0x1AFF5, 0x1AFFB) X(0x1AFFD, 0x1AFFE) X(0x1B000, 0x1B122)\
+    X(0x1B150, 0x1B152) X(0x1B164, 0x1B167) X(0x1B170, 0x1B2FB) X(0x1BC00, 0x1BC6A)\
+    X(0x1BC70, 0x1BC7C) X(0x1BC80, 0x1BC88) X(0x1BC90, 0x1BC99) X(0x1BC9D, 0x1BC9E)\
+    X(0x1CF00, 0x1CF2D) X(0x1CF30, 0x1CF46) X(0x1D165, 0x1D169) X(0x1D16D, 0x1D172)\
+    X(0x1D17B, 0x1D182) X(0x1D185, 0x1D18B) X(0x1D1AA, 0x1D1AD) X(0x1D242, 0x1D244)\
+    X(0x1D400, 0x1D454) X(0x1D456, 0x1D49C) X(0x1D49E, 0x1D49F) X(0x1D4A2, 0x1D4A2)\
+    X(0x1D4A5, 0x1D4A6) X(0x1D4A9, 0x1D4AC) X(0x1D4AE, 0x1D4B9) X(0x1D4BB, 0x1D4BB)\
+    X(0x1D4BD, 0x1D4C3) X(0x1D4C5, 0x1D505) X(0x1D507, 0x1D50A) X(0x1D50D, 0x1D514)\
+    X(0x1D516, 0x1D51C) X(0x1D51E, 0x1D539) X(0x1D53B, 0x1D53E) X(0x1D540, 0x1D544)\
+    X(0x1D546, 0x1D546) X(0x1D54A, 0x1D550) X(0x1D552, 0x1D6A5) X(0x1D6A8, 0x1D6C0)\
+    X(0x1D6C2, 0x1D6DA) X(0x1D6DC, 0x1D6FA) X(0x1D6FC, 0x1D714) X(0x1D716, 0x1D734)\
+    X(0x1D736, 0x1D74E) X(0x1D750, 0x1D76E) X(0x1D770, 0x1D788) X(0x1D78A, 0x1D7A8)\
+    X(0x1D7AA, 0x1D7C2) X(0x1D7C4, 0x1D7CB) X(0x1D7CE, 0x1D7FF) X(0x1DA00, 0x1DA36)\
+    X(0x1DA3B, 0x1DA6C) X(0x1DA75, 0x1DA75) X(0x1DA84, 0x1DA84) X(0x1DA9B, 0x1DA9F)\
+    X(0x1DAA1, 0x1DAAF) X(0x1DF00, 0x1DF1E) X(0x1E000, 0x1E006) X(0x1E008, 0x1E018)\
+    X(0x1E01B, 0x1E021) X(0x1E023, 0x1E024) X(0x1E026, 0x1E02A) X(0x1E100, 0x1E12C)\
+    X(0x1E130, 0x1E13D) X(0x1E140, 0x1E149) X(0x1E14E, 0x1E14E) X(0x1E290, 0x1E2AE)\
+    X(0x1E2C0, 0x1E2F9) X(0x1E7E0, 0x1E7E6) X(0x1E7E8, 0x1E7EB) X(0x1E7ED, 0x1E7EE)\
+    X(0x1E7F0, 0x1E7FE) X(0x1E800, 0x1E8C4) X(0x1E8D0, 0x1E8D6) X(0x1E900, 0x1E94B)\
+    X(0x1E950, 0x1E959) X(0x1EE00, 0x1EE03) X(0x1EE05, 0x1EE1F) X(0x1EE21, 0x1EE22)\
+    X(0x1EE24, 0x1EE24) X(0x1EE27, 0x1EE27) X(0x1EE29, 0x1EE32) X(0x1EE34, 0x1EE37)\
+    X(0x1EE39, 0x1EE39) X(0x1EE3B, 0x1EE3B) X(0x1EE42, 0x1EE42) X(0x1EE47, 0x1EE47)\
+    X(0x1EE49, 0x1EE49) X(0x1EE4B, 0x1EE4B) X(0x1EE4D, 0x1EE4F) X(0x1EE51, 0x1EE52)\
+    X(0x1EE54, 0x1EE54) X(0x1EE57, 0x1EE57) X(0x1EE59, 0x1EE59) X(0x1EE5B, 0x1EE5B)\
+    X(0x1EE5D, 0x1EE5D) X(0x1EE5F, 0x1EE5F) X(0x1EE61, 0x1EE62) X(0x1EE64, 0x1EE64)\
+    X(0x1EE67, 0x1EE6A) X(0x1EE6C, 0x1EE72) X(0x1EE74, 0x1EE77) X(0x1EE79, 0x1EE7C)\
+    X(0x1EE7E, 0x1EE7E) X(0x1EE80, 0x1EE89) X(0x1EE8B, 0x1EE9B) X(0x1EEA1, 0x1EEA3)\
+    X(0x1EEA5, 0x1EEA9) X(0x1EEAB, 0x1EEBB) X(0x1FBF0, 0x1FBF9) X(0x20000, 0x2A6DF)\
+    X(0x2A700, 0x2B738) X(0x2B740, 0x2B81D) X(0x2B820, 0x2CEA1) X(0x2CEB0, 0x2EBE0)\
+    X(0x2F800, 0x2FA1D) X(0x30000, 0x3134A) X(0xE0100, 0xE01EF)             \
+
+#endif // UNICODE_XID_H
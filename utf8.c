@@ -0,0 +1,21 @@
+#include "utf8.h"
+
+#include "xid.gen.h"
+
+static bool lookup(const uint8_t *index, uint32_t len, uint32_t cp)
+{
+    uint32_t chunk = cp >> XID_CHUNK_BITS;
+    if (chunk >= len) return false;
+    uint32_t bit = cp & ((1 << XID_CHUNK_BITS) - 1);
+    return xid_chunks[index[chunk]][bit / 64] >> (bit % 64) & 1;
+}
+
+bool is_xid_start(uint32_t cp)
+{
+    return lookup(xid_start_index, XID_START_LEN, cp);
+}
+
+bool is_xid_continue(uint32_t cp)
+{
+    return lookup(xid_continue_index, XID_CONTINUE_LEN, cp);
+}
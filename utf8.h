@@ -0,0 +1,51 @@
+#ifndef UTF8_H
+#define UTF8_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// The longest character, in bytes.
+#define UTF8_MAX_LEN 4
+
+// Decodes the character at `s`, which must be before `end`.  Returns its
+// length, or 0 if it is not well-formed UTF-8: a stray continuation byte, a
+// truncated sequence, an overlong form, a surrogate or a value past
+// U+10FFFF.
+static inline size_t utf8_decode(const char *s, const char *end, uint32_t *cp)
+{
+    const unsigned char *p = (const unsigned char *)s;
+    size_t avail = end - s;
+    uint32_t c = p[0];
+    if (c < 0x80) {
+        *cp = c;
+        return 1;
+    }
+    if (c < 0xc2) return 0;
+    if (c < 0xe0) {
+        if (avail < 2 || (p[1] & 0xc0) != 0x80) return 0;
+        *cp = (c & 0x1f) << 6 | (p[1] & 0x3f);
+        return 2;
+    }
+    if (c < 0xf0) {
+        if (avail < 3 || (p[1] & 0xc0) != 0x80 || (p[2] & 0xc0) != 0x80) return 0;
+        c = (c & 0x0f) << 12 | (p[1] & 0x3f) << 6 | (p[2] & 0x3f);
+        if (c < 0x800 || (c >= 0xd800 && c < 0xe000)) return 0;
+        *cp = c;
+        return 3;
+    }
+    if (c < 0xf5) {
+        if (avail < 4 || (p[1] & 0xc0) != 0x80 || (p[2] & 0xc0) != 0x80 || (p[3] & 0xc0) != 0x80) return 0;
+        c = (c & 0x07) << 18 | (p[1] & 0x3f) << 12 | (p[2] & 0x3f) << 6 | (p[3] & 0x3f);
+        if (c < 0x10000 || c > 0x10ffff) return 0;
+        *cp = c;
+        return 4;
+    }
+    return 0;
+}
+
+// The identifier properties of UAX #31, for code points outside ASCII.
+bool is_xid_start(uint32_t cp);
+bool is_xid_continue(uint32_t cp);
+
+#endif // UTF8_H